@@ -0,0 +1,139 @@
+/*
+    offline capture throughput : pc_sniffer::init_file (pcap_loop) against init_file_parallel with 1..N workers
+    every handler runs decode_pack (what the client does before publishing / aggregating)
+    usage : bench_file [size_mb] [max_workers] [file.pcap]
+    without a file a synthetic classic pcap of size_mb (default 4096) is written to bench_file.pcap
+    (ethernet / IPv4 / TCP and UDP, 64..1514 byte frames), an existing file of that size is reused
+*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <sys/stat.h>
+
+#include "../external/sniffer/sniffer.h"
+#include "../external/decoder/decoder.h"
+
+using namespace std;
+
+static void put16(u_char *p, unsigned v) { p[0] = v >> 8; p[1] = v & 255; }
+static void put32(u_char *p, uint32_t v) { put16(p, v >> 16); put16(p + 2, v & 0xffff); }
+
+static void generate(const string &path, uint64_t size)
+{
+    ofstream f(path, ios::binary | ios::trunc);
+    if (!f)
+        throw runtime_error("bench_file: can't write " + path);
+
+    // classic pcap (host order), microseconds, ethernet
+    struct
+    {
+        uint32_t magic = 0xa1b2c3d4;
+        uint16_t major = 2, minor = 4;
+        int32_t thiszone = 0;
+        uint32_t sigfigs = 0, snaplen = 65535, network = 1;
+    } hdr;
+    f.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+
+    vector<u_char> buf;
+    buf.reserve(1 << 20);
+    uint64_t written = sizeof(hdr), ts = 1700000000ull * 1000000, seed = 1;
+    while (written + buf.size() < size)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        uint32_t r = seed >> 33;
+        uint32_t len = 64 + r % 1451;
+        bool tcp = r & 1;
+        ts += 1 + r % 16;
+
+        uint32_t rec[4] = {static_cast<uint32_t>(ts / 1000000), static_cast<uint32_t>(ts % 1000000), len, len};
+        size_t at = buf.size();
+        buf.resize(at + sizeof(rec) + len);
+        memcpy(&buf[at], rec, sizeof(rec));
+
+        u_char *p = &buf[at + sizeof(rec)];
+        memset(p, 0, len);
+        put32(p + 8, r); // src mac
+        put16(p + 12, 0x0800);
+        u_char *ip = p + 14;
+        ip[0] = 0x45;
+        put16(ip + 2, len - 14);
+        ip[8] = 64;
+        ip[9] = tcp ? 6 : 17;
+        put32(ip + 12, 0x0a000000 | (r & 0xffff));
+        put32(ip + 16, 0xc0a80000 | (r >> 16 & 0xff));
+        put16(ip + 20, 1024 + (r & 0x3fff));
+        put16(ip + 22, tcp ? 443 : 53);
+        if (tcp)
+            ip[20 + 13] = 0x10; // ACK
+
+        if (buf.size() >= (1 << 20) - 2048)
+        {
+            f.write(reinterpret_cast<const char *>(buf.data()), buf.size());
+            written += buf.size();
+            buf.clear();
+        }
+    }
+    f.write(reinterpret_cast<const char *>(buf.data()), buf.size());
+}
+
+static void decode(u_char *, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, const u_char *data)
+{
+    thread_local uint64_t ok = 0;
+    decoded_pack dp;
+    ok += decode_pack(data, cap, len, tv_sec, tv_usec, dp);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t size_mb = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4096;
+    uint32_t max_workers = argc > 2 ? strtoul(argv[2], nullptr, 10) : max(1u, thread::hardware_concurrency());
+    string path = argc > 3 ? argv[3] : "bench_file.pcap";
+
+    struct stat sb;
+    if (argc <= 3 && (stat(path.c_str(), &sb) != 0 || static_cast<uint64_t>(sb.st_size) / (1 << 20) != size_mb))
+    {
+        cout << "writing " << size_mb << " MiB to " << path << endl;
+        generate(path, size_mb << 20);
+    }
+    if (stat(path.c_str(), &sb) != 0)
+    {
+        cerr << "bench_file: can't stat " << path << endl;
+        return 1;
+    }
+    double gb = sb.st_size / 1e9;
+    using clock = chrono::steady_clock;
+
+    double base = 0;
+    uint64_t packets = 0;
+    for (uint32_t w = 1; w <= max_workers; w = w < max_workers && w * 2 > max_workers ? max_workers : w * 2)
+    {
+        pc_sniffer pc;
+        pc.h_func = decode;
+        file_options opt;
+        opt.workers = w;
+        file_stats st = pc.init_file_parallel(path.c_str(), opt);
+        double pps = st.total_s > 0 ? st.packets / st.total_s : 0;
+        if (w == 1)
+            base = pps;
+        packets = st.packets;
+        cout << "init_file_parallel " << w << " workers : " << pps / 1e6 << " Mpkt/s, " << gb / st.total_s << " GB/s (index " << st.index_s
+             << " s) speedup " << (base > 0 ? pps / base : 0) << "x" << endl;
+        if (w == max_workers)
+            break;
+    }
+
+    // single pcap_loop, same handler (packet count from the parallel runs)
+    pc_sniffer pc;
+    pc.h_func = decode;
+    auto t0 = clock::now();
+    pc.init_file(path.c_str());
+    double s = chrono::duration<double>(clock::now() - t0).count();
+    cout << "init_file (pcap_loop)        : " << (packets / s) / 1e6 << " Mpkt/s, " << gb / s << " GB/s" << endl;
+    return 0;
+}
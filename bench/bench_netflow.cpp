@@ -0,0 +1,142 @@
+/*
+    netflow v9 / IPFIX decoding throughput (netflow_v9_v10::decoder, one decoder per thread, shared template_store)
+    usage : bench_netflow [threads] [rounds] [file.pcap]
+    without a file : synthetic v9 and IPFIX exports (18 fields / 45 byte records, 30 records per packet,
+    template refreshed every 1000 packets, 16 exporters)
+    with a file : UDP payloads of a classic pcap (ethernet / IPv4) starting with version 9 or 10
+*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#include "../external/netflow_parser/netflow.hpp"
+#include "../test/netflow_export.h"
+
+using namespace std;
+using namespace netflow_v9_v10;
+
+struct export_packet
+{
+    array<uint8_t, 16> exporter;
+    vector<u_char> data;
+};
+
+// {field type, length} of a common v9 / IPFIX IPv4 template
+static const vector<export_field> fields = {
+    {1, 4}, {2, 4}, {4, 1}, {5, 1}, {6, 1}, {7, 2}, {8, 4}, {9, 1}, {10, 2},
+    {11, 2}, {12, 4}, {13, 1}, {14, 2}, {15, 4}, {16, 2}, {17, 2}, {21, 4}, {22, 4}};
+
+static vector<u_char> make_packet(int version, uint32_t seq, bool with_template, int records)
+{
+    export_packet_builder w(version, 1, seq);
+    if (with_template)
+        w.tmpl(256, fields);
+
+    vector<vector<uint64_t>> values(records);
+    for (int r = 0; r < records; r++)
+    {
+        uint32_t v = seq * 31 + r;
+        for (size_t f = 0; f < fields.size(); f++)
+        {
+            values[r].push_back(v);
+            v = v * 1103515245 + 12345;
+        }
+    }
+    w.data(256, fields, values);
+    return w.b;
+}
+
+static vector<export_packet> synthetic()
+{
+    vector<export_packet> out;
+    for (uint32_t i = 0; i < 16000; i++)
+    {
+        uint32_t exp = i % 16;
+        int version = exp % 2 ? 10 : 9;
+        out.push_back({template_key::from_ipv4(0x0a000001 + exp), make_packet(version, i, i < 16 || i % 1000 < 16, 30)});
+    }
+    return out;
+}
+
+static vector<export_packet> read_pcap(const char *path)
+{
+    ifstream in(path, ios::binary);
+    vector<u_char> f((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (f.size() < 24 || (f[0] != 0xd4 || f[1] != 0xc3))
+        throw runtime_error("classic little endian pcap expected");
+
+    vector<export_packet> out;
+    for (size_t off = 24; off + 16 <= f.size();)
+    {
+        uint32_t cap;
+        memcpy(&cap, &f[off + 8], 4);
+        const u_char *p = &f[off + 16];
+        off += 16 + cap;
+        if (off > f.size() || cap < 14 + 20 + 8 || p[12] != 0x08 || p[13] != 0x00)
+            continue;
+        size_t ihl = (p[14] & 15) * 4;
+        if (p[14 + 9] != 17 || cap < 14 + ihl + 8 + 4)
+            continue;
+        const u_char *udp = p + 14 + ihl;
+        uint16_t version = (udp[8] << 8) | udp[9];
+        if (version != 9 && version != 10)
+            continue;
+        uint32_t src = (p[26] << 24) | (p[27] << 16) | (p[28] << 8) | p[29];
+        out.push_back({template_key::from_ipv4(src), vector<u_char>(udp + 8, p + cap)});
+    }
+    return out;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned threads = argc > 1 ? atoi(argv[1]) : 1;
+    unsigned rounds = argc > 2 ? atoi(argv[2]) : 20;
+    vector<export_packet> packets = argc > 3 ? read_pcap(argv[3]) : synthetic();
+    size_t bytes = 0;
+    for (auto &p : packets)
+    {
+        bytes += p.data.size();
+    }
+
+    auto store = make_shared<template_store>();
+    atomic<uint64_t> records{0}, errors{0}, checksum{0};
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pool.emplace_back([&]()
+                          {
+            decoder d(store);
+            record_batch batch;
+            uint64_t n = 0, sum = 0, err = 0;
+            auto sink = [&sum](const template_key &, const record_batch &b){
+                for (size_t r = 0; r < b.rows; r++)
+                    sum += b.u64(0, r);
+            };
+            for (unsigned r = 0; r < rounds; r++)
+                for (auto &p : packets){
+                    try{ n += d.decode(p.exporter, p.data.data(), p.data.size(), batch, sink); }
+                    catch (const exception &){ err++; }
+                }
+            records += n;
+            errors += err;
+            checksum += sum; });
+    }
+    for (auto &t : pool)
+    {
+        t.join();
+    }
+    double s = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    uint64_t total_packets = uint64_t(packets.size()) * rounds * threads;
+    cout << "threads " << threads << " packets " << total_packets << " records " << records << " errors " << errors << " (checksum " << checksum << ")\n";
+    cout << total_packets / s / 1e6 << " Mpkt/s, " << records / s / 1e6 << " Mrec/s, " << double(bytes) * rounds * threads / s / 1e6 << " MB/s" << endl;
+    return 0;
+}
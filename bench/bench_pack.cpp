@@ -0,0 +1,177 @@
+/*
+    packet -> serialized protobuf record, old path (text fields in pack, like the first client handler)
+    against decode_pack + to_proto (pack_v2 on an arena)
+    usage : bench_pack [packets]
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#include <arpa/inet.h>
+#include <net/ethernet.h>
+#include <netinet/ether.h>
+#include <netinet/ip.h>
+#include <netinet/ip6.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+
+#include <google/protobuf/arena.h>
+
+#include "../external/decoder/decoder.h"
+#include "../external/protobuff/gen/pack.pb.h"
+#include "../external/protobuff/gen/pack_v2.pb.h"
+
+using namespace std;
+
+// ethernet + ipv4/ipv6 + tcp/udp, 3 of 4 frames ipv4
+static vector<vector<u_char>> make_frames(size_t n)
+{
+    vector<vector<u_char>> frames(n);
+    uint32_t seed = 1;
+    auto rnd = [&seed]()
+    { return seed = seed * 1664525 + 1013904223; };
+
+    for (size_t i = 0; i < n; i++)
+    {
+        bool v6 = i % 4 == 3, tcp = i % 3 != 0;
+        size_t l3 = v6 ? sizeof(ip6_hdr) : sizeof(ip), l4 = tcp ? sizeof(tcphdr) : sizeof(udphdr);
+        vector<u_char> &f = frames[i];
+        f.assign(ETH_HLEN + l3 + l4 + rnd() % 64, 0);
+        for (auto &b : f)
+        {
+            b = rnd() >> 24;
+        }
+
+        ether_header *eth = reinterpret_cast<ether_header *>(f.data());
+        eth->ether_type = htons(v6 ? ETHERTYPE_IPV6 : ETHERTYPE_IP);
+        u_char *p = f.data() + ETH_HLEN;
+        if (v6)
+        {
+            ip6_hdr *h = reinterpret_cast<ip6_hdr *>(p);
+            h->ip6_vfc = 0x60;
+            h->ip6_nxt = tcp ? IPPROTO_TCP : IPPROTO_UDP;
+            h->ip6_plen = htons(f.size() - ETH_HLEN - l3);
+        }
+        else
+        {
+            ip *h = reinterpret_cast<ip *>(p);
+            h->ip_v = 4;
+            h->ip_hl = 5;
+            h->ip_off = 0;
+            h->ip_p = tcp ? IPPROTO_TCP : IPPROTO_UDP;
+            h->ip_len = htons(f.size() - ETH_HLEN);
+        }
+    }
+    return frames;
+}
+
+// first client handler without the output (text addresses, one allocation + copy per packet)
+static void old_path(const u_char *data, uint32_t len, __suseconds_t tv_usec, pack &pa, string &out)
+{
+    char *p = new char[len];
+    memcpy(p, data, len);
+
+    size_t idx = ETH_HLEN;
+    ether_header eth = *(ether_header *)p;
+    pa.Clear();
+    pa.set_time(tv_usec);
+    pa.set_framesize(len);
+    pa.set_s_mac(ether_ntoa((ether_addr *)eth.ether_shost));
+    pa.set_d_mac(ether_ntoa((ether_addr *)eth.ether_dhost));
+
+    uint8_t proto = 0;
+    if (ntohs(eth.ether_type) == ETHERTYPE_IP)
+    {
+        ip h = *(ip *)(p + idx);
+        idx += sizeof(h);
+        pa.set_ipv(h.ip_v);
+        char a[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &h.ip_src, a, sizeof(a));
+        pa.set_s_ip(a);
+        inet_ntop(AF_INET, &h.ip_dst, a, sizeof(a));
+        pa.set_d_ip(a);
+        proto = h.ip_p;
+    }
+    else
+    {
+        ip6_hdr h = *(ip6_hdr *)(p + idx);
+        idx += sizeof(h);
+        pa.set_ipv(6);
+        char a[INET6_ADDRSTRLEN];
+        inet_ntop(AF_INET6, &h.ip6_src, a, sizeof(a));
+        pa.set_s_ip(a);
+        inet_ntop(AF_INET6, &h.ip6_dst, a, sizeof(a));
+        pa.set_d_ip(a);
+        proto = h.ip6_nxt;
+    }
+
+    if (proto == IPPROTO_TCP)
+    {
+        tcphdr t = *(tcphdr *)(p + idx);
+        pa.set_t_proto("TCP");
+        pa.set_s_port(t.th_sport);
+        pa.set_d_port(t.th_dport);
+    }
+    else
+    {
+        udphdr u = *(udphdr *)(p + idx);
+        pa.set_t_proto("UDP");
+        pa.set_s_port(u.uh_sport);
+        pa.set_d_port(u.uh_dport);
+    }
+
+    pa.SerializeToString(&out);
+    delete[] p;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    vector<vector<u_char>> frames = make_frames(4096);
+    const __time_t sec = 1700000000;
+
+    using clock = chrono::steady_clock;
+    uint64_t bytes_old = 0, bytes_new = 0, bytes_old4 = 0, bytes_new4 = 0, n4 = 0;
+
+    pack pa;
+    string out;
+    auto t0 = clock::now();
+    for (size_t i = 0; i < n; i++)
+    {
+        const vector<u_char> &f = frames[i % frames.size()];
+        old_path(f.data(), f.size(), i % 1000000, pa, out);
+        bytes_old += out.size();
+        if (i % 4 != 3)
+            bytes_old4 += out.size();
+    }
+    double s_old = chrono::duration<double>(clock::now() - t0).count();
+
+    google::protobuf::Arena arena;
+    pack_v2 *pv = new_pack_v2(&arena);
+    decoded_pack dp;
+    t0 = clock::now();
+    for (size_t i = 0; i < n; i++)
+    {
+        const vector<u_char> &f = frames[i % frames.size()];
+        decode_pack(f.data(), f.size(), f.size(), sec, i % 1000000, dp);
+        to_proto(dp, pv);
+        pv->SerializeToString(&out);
+        bytes_new += out.size();
+        if (i % 4 != 3)
+        {
+            bytes_new4 += out.size();
+            n4++;
+        }
+    }
+    double s_new = chrono::duration<double>(clock::now() - t0).count();
+
+    cout << "packets " << n << " (3/4 ipv4, 1/4 ipv6)\n";
+    cout << "pack    : " << s_old * 1e9 / n << " ns/pkt, " << double(bytes_old) / n << " B/record (ipv4 " << double(bytes_old4) / n4 << ")\n";
+    cout << "pack_v2 : " << s_new * 1e9 / n << " ns/pkt, " << double(bytes_new) / n << " B/record (ipv4 " << double(bytes_new4) / n4 << ")\n";
+    cout << "speedup " << s_old / s_new << "x, size " << 100.0 * bytes_new / bytes_old << "% (ipv4 " << 100.0 * bytes_new4 / bytes_old4 << "%)" << endl;
+    return 0;
+}
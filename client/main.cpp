@@ -1,26 +1,75 @@
 #include <iostream>
 #include <thread>
+#include <chrono>
 
-#include <netinet/ether.h>
-#include <netinet/ip.h>
-#include <netinet/ip6.h>
-#include <netinet/in.h>
-#include <netinet/udp.h>
-#include <netinet/tcp.h>
-#include <arpa/inet.h>
+#include <string>
+
+#include <google/protobuf/arena.h>
 
 #include "../external/sniffer/sniffer.h"
-#include "../external/protobuff/gen/pack.pb.h"
+#include "../external/decoder/decoder.h"
+#include "../external/nats-client/nc.h"
+#include "../external/flow_table/flow_table.h"
+#include "../external/protobuff/gen/pack_v2.pb.h"
 
 using namespace std;
 
 void handler(u_char *user, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, const u_char *data);
 
+static constexpr char const *subject = "sniff.base", *flow_subject = "sniff.flows";
+nats_client *publisher = nullptr; // set if the packets are sent to nats-server
+bool aggregate = false;           // packets -> flow_table -> flow_v2 instead of one pack_v2 per packet
+
+// flow table of the calling capture thread, emits the remaining flows when the thread ends
+// the message and buffers used by emit are members declared before t : they outlive the flush in the destructor
+struct thread_flows
+{
+    google::protobuf::Arena arena;
+    flow_v2 *fl = google::protobuf::Arena::CreateMessage<flow_v2>(&arena);
+    string out;
+    flow_table t;
+
+    thread_flows() : t([this](const flow_record &r){ emit_flow(r); }) {}
+    thread_flows(const thread_flows &) = delete;
+    thread_flows &operator=(const thread_flows &) = delete;
+    ~thread_flows() { t.flush(); }
+
+    void emit_flow(const flow_record &r)
+    {
+        to_proto(r, fl);
+        fl->SerializeToString(&out);
+
+        if (publisher != nullptr)
+            publisher->publish_async(out.data(), out.size());
+    }
+};
+
+flow_table &flows()
+{
+    thread_local thread_flows f;
+    return f.t;
+}
+
 int main()
 {
     pc_sniffer pc;
     pc.h_func = handler;
-    cout << "1) init from file\n2) init from interface\n-";
+
+    short n;
+    cout << "aggregate packets into flows 1) yes 0) no\n-";
+    cin >> n;
+    aggregate = n == 1;
+
+    nats_client nc;
+    cout << "publish to nats-server (" << (aggregate ? flow_subject : subject) << ") 1) yes 0) no\n-";
+    cin >> n;
+    if (n == 1){
+        nc.nats_client_connect();
+        nc.start_async(aggregate ? flow_subject : subject);
+        publisher = &nc;
+    }
+
+    cout << "1) init from file\n2) init from interface\n3) init from interface (mmap ring, multi-thread)\n4) init from file (parallel, pcap/pcapng)\n-";
     short o;
     cin >> o;
     string I_F_name;
@@ -30,7 +79,13 @@ int main()
 
         // pc.init_file(I_F_name.c_str());
         pc.init_file("/home/Nihill/Documents/out/pcap_exaples/release/pcapfiles/netflow_many_packets_dump.pcap");
-        
+
+        if (aggregate){
+            flows().flush();
+            flow_table_stats st = flows().stats();
+            cout << "packets " << st.packets << " flows " << st.created << " max size " << st.max_size << '/' << st.capacity
+                 << " idle " << st.idle << " active " << st.active << " fin/rst " << st.fin_rst << " pressure " << st.pressure << endl;
+        }
     }else if (o == 2){
         pc.show_interfaces();
         cout << '-';
@@ -47,130 +102,77 @@ int main()
         }
 
         th.join();
-    }
-    return 0;
-}
-
-void handler(u_char *user, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, const u_char *data)
-{
-    if (cap != len)
-        return;
-
-    char *p = new char[len];
-    // copy(data, data + len, p);
-    for (uint32_t i = 0; i < len; i++){ p[i] = data[i]; }
-/*
-    for (int i = 0; i < len; i++){
-        if (isprint(data[i])){
-            cout << data[i];
-        }else{ cout << '.'; }
-    }
-
-    cout << "\n\n\n\n\n";
-*/
-
-    uint16_t data_index = 0;
-    pack pa;
-    pa.set_time(tv_usec);
-    pa.set_framesize(len);
+    }else if (o == 3){
+        pc.show_interfaces();
+        cout << '-';
+        cin >> I_F_name;
 
-    ether_header eth = *(ether_header*)(p + data_index);
-    data_index += ETH_HLEN;
+        ring_options opt;
+        opt.workers = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+        pc.init_ring(I_F_name.c_str(), opt);
+        // no packets -> no sweep in add(), time out the flows of the idle worker here (its own table)
+        if (aggregate)
+            pc.set_idle_handler([](uint32_t){
+                flows().expire(chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count());
+            });
+        cout << "1) break loop\n2) show ring stats\n";
 
-    pa.set_s_mac(ether_ntoa((ether_addr*)eth.ether_shost));
-    pa.set_d_mac(ether_ntoa((ether_addr*)eth.ether_dhost));
+        thread th([&](){pc.scan_ring();});
 
-    uint8_t ip_tos;
-    switch (ntohs(eth.ether_type))
-    {
-    case ETHERTYPE_IP:
-        {
-            ip iph = *(ip*)(p + data_index);
-            data_index += sizeof(iph);
-            
-            pa.set_ipv(iph.ip_v);
-
-            char ipa[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &iph.ip_src, ipa, INET_ADDRSTRLEN);
-            pa.set_s_ip(ipa);
-            inet_ntop(AF_INET, &iph.ip_dst, ipa, INET_ADDRSTRLEN);
-            pa.set_d_ip(ipa);
-
-            ip_tos = iph.ip_p;
+        while(1){
+            cout << '-';
+            cin >> o;
+            if (o == 1){ pc.breakloop(); break; }
+            if (o == 2){
+                for (uint32_t i = 0; i < pc.ring_workers(); i++){
+                    ring_stats st = pc.get_ring_stats(i);
+                    cout << "worker " << i << " packets " << st.packets << " drops " << st.drops << " blocks " << st.blocks_in_use << '/' << st.block_count << endl;
+                }
+            }
         }
-        break;
-
-    case ETHERTYPE_IPV6:
-        {
-            ip6_hdr iph = *(ip6_hdr*)(p + data_index);
-            data_index += sizeof(iph);
 
-            pa.set_ipv(iph.ip6_ctlun.ip6_un2_vfc);
+        th.join();
+    }else if (o == 4){
+        cout << "type file path and name\n-";
+        cin >> I_F_name;
 
-            char ipa[INET6_ADDRSTRLEN];
-            inet_ntop(AF_INET6, &iph.ip6_src, ipa, INET6_ADDRSTRLEN);
-            pa.set_s_ip(ipa);
-            inet_ntop(AF_INET6, &iph.ip6_dst, ipa, INET6_ADDRSTRLEN);
-            pa.set_d_ip(ipa);
+        // worker threads flush their flow tables when they end, the calling thread is worker 0
+        file_options opt;
+        file_stats st = pc.init_file_parallel(I_F_name.c_str(), opt);
+        if (aggregate)
+            flows().flush();
 
-            ip_tos = iph.ip6_ctlun.ip6_un1.ip6_un1_nxt;
-        }
-        break;
-    
-    default:
-        {
-            pa.set_ipv(0);
-            pa.set_s_ip("UNDEFINED");
-            pa.set_d_ip("UNDEFINED");
-        }
-        break;
+        cout << "packets " << st.packets << " bytes " << st.bytes << " chunks " << st.chunks
+             << " index " << st.index_s << "s total " << st.total_s << "s (" << (st.total_s > 0 ? st.packets / st.total_s : 0) << " pkt/s)" << endl;
     }
 
-    switch (ip_tos)
-    {
-    case IPPROTO_TCP:
-        {
-            tcphdr prth = *(tcphdr*)(p + data_index);
-            data_index += sizeof(prth);
-
-            pa.set_t_proto("TCP");
+    if (publisher != nullptr){
+        nc.stop_async();
+        async_stats st = nc.get_async_stats();
+        cout << "queued " << st.queued << " sent " << st.sent << " dropped " << st.dropped << " batches " << st.batches << endl;
+    }
+    return 0;
+}
 
-            pa.set_s_port(prth.th_sport);
-            pa.set_d_port(prth.th_dport);
-        }
-        break;
-    case IPPROTO_UDP:
-        {
-            udphdr prth = *(udphdr*)(p + data_index);
-            data_index += sizeof(prth);
+void handler(u_char *user, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, const u_char *data)
+{
+    // one arena/message/output buffer per capture thread, reused for every packet
+    thread_local google::protobuf::Arena arena;
+    thread_local pack_v2 *pa = new_pack_v2(&arena);
+    thread_local string out;
 
-            pa.set_t_proto("UDP");
+    decoded_pack dp;
+    if (!decode_pack(data, cap, len, tv_sec, tv_usec, dp))
+        return;
 
-            pa.set_s_port(prth.uh_sport);
-            pa.set_d_port(prth.uh_dport);
-        }
-        break;
-    
-    default:
-        {
-            pa.set_t_proto("UNDEFINED");
-
-            pa.set_s_port(0);
-            pa.set_d_port(0);
-        }
-        break;
+    if (aggregate){
+        flows().add(dp);
+        return;
     }
 
-    cout << pa.framesize() << endl;
-    cout << pa.s_mac() << endl;
-    cout << pa.d_mac() << endl;
-    cout << pa.ipv() << endl;
-    cout << pa.s_ip() << endl;
-    cout << pa.d_ip() << endl;
-    cout << pa.t_proto() << endl;
-    cout << pa.s_port() << endl;
-    cout << pa.d_port() << endl;
-    cout << "\n\n";
-
-    delete p;
+    to_proto(dp, pa);
+    pa->SerializeToString(&out);
+
+    if (publisher != nullptr)
+        publisher->publish_async(out.data(), out.size());
 }
\ No newline at end of file
@@ -1,24 +1,398 @@
 #pragma once
 
 #include <clickhouse/client.h>
-#include <vector>
-#include <map>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <exception>
 #include <utility>
+#include <type_traits>
 
-class database
+// flush triggers for table_writer (the first one reached wins)
+struct writer_options
+{
+    size_t max_rows = 100000;
+    size_t max_bytes = 16 * 1024 * 1024; // estimated size of the appended values
+    std::chrono::milliseconds max_age{1000}; // age of the first row in the buffer
+};
+
+struct writer_stats
+{
+    uint64_t inserts = 0, rows = 0, errors = 0;
+    uint64_t last_latency_us = 0, max_latency_us = 0, total_latency_us = 0;
+    double rows_per_s = 0; // inserted rows / time since the writer was created
+    // rows added with append_timed : oldest source time of an insert -> insert done (system clock)
+    uint64_t e2e_inserts = 0, last_e2e_us = 0, max_e2e_us = 0, total_e2e_us = 0;
+};
+
+/*
+    typed bulk writer for one table, C... are clickhouse column types (ColumnUInt32, ColumnIPv4, ...)
+    append(v...) writes value I into column I (resolved at compile time)
+
+    two column buffers : the caller fills one while a background thread inserts the other
+    with its own clickhouse::Client, append blocks only if both buffers are full
+    an insert error is rethrown from the next append/flush
+*/
+template <class... C>
+class table_writer
 {
 private:
-    clickhouse::ClientOptions cl_options;
+    static constexpr size_t col_count = sizeof...(C);
+
+    struct buffer
+    {
+        std::tuple<std::shared_ptr<C>...> cols{std::make_shared<C>()...};
+        size_t rows = 0, bytes = 0;
+        std::chrono::steady_clock::time_point first;
+        uint64_t src_us = UINT64_MAX; // oldest append_timed source time
+    };
+
     clickhouse::Client client;
+    const std::string table;
+    const std::array<std::string, col_count> names;
+    const writer_options opt;
+
+    buffer buffs[2];
+    int active = 0;
+    bool pending = false; // buffs[active ^ 1] waits for insert / is being inserted
+    bool stop = false;
+    std::exception_ptr error;
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::thread th;
+
+    const std::chrono::steady_clock::time_point created = std::chrono::steady_clock::now();
+    std::atomic<uint64_t> s_inserts{0}, s_rows{0}, s_errors{0}, s_last{0}, s_max{0}, s_total{0};
+    std::atomic<uint64_t> s_e2e_inserts{0}, s_e2e_last{0}, s_e2e_max{0}, s_e2e_total{0};
+
+    template <class V>
+    static size_t value_bytes(const V &v)
+    {
+        if constexpr (std::is_convertible_v<const V &, std::string_view>)
+            return std::string_view(v).size();
+        else
+            return sizeof(V);
+    }
+
+    template <class V>
+    static size_t column_bytes(const V *v, size_t rows)
+    {
+        if constexpr (std::is_convertible_v<const V &, std::string_view>)
+        {
+            size_t n = 0;
+            for (size_t i = 0; i < rows; i++)
+                n += std::string_view(v[i]).size();
+            return n;
+        }
+        else
+            return rows * sizeof(V);
+    }
+
+    template <size_t I, class V>
+    static void append_column(buffer &b, size_t rows, const V *v)
+    {
+        auto &col = std::get<I>(b.cols);
+        for (size_t i = 0; i < rows; i++)
+            col->Append(v[i]);
+    }
+
+    // drop the values past b.rows (left by an Append that threw on a later column)
+    template <size_t I>
+    void truncate_column(buffer &b)
+    {
+        auto &col = std::get<I>(b.cols);
+        if (col->Size() > b.rows)
+            col = col->Slice(0, b.rows)->template As<std::tuple_element_t<I, std::tuple<C...>>>();
+    }
+
+    // all columns get the value or none of them
+    template <size_t... I, class... V>
+    void append_row(buffer &b, std::index_sequence<I...>, V &&...v)
+    {
+        try
+        {
+            (std::get<I>(b.cols)->Append(std::forward<V>(v)), ...);
+        }
+        catch (...)
+        {
+            (truncate_column<I>(b), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I, class... V>
+    void append_bulk(buffer &b, std::index_sequence<I...>, size_t rows, const V *...v)
+    {
+        try
+        {
+            (append_column<I>(b, rows, v), ...);
+        }
+        catch (...)
+        {
+            (truncate_column<I>(b), ...);
+            throw;
+        }
+    }
+
+    void rethrow_error()
+    {
+        if (error)
+        {
+            std::exception_ptr e = error;
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    // caller holds the lock : hand the active buffer to the background thread
+    void swap_locked(std::unique_lock<std::mutex> &lock)
+    {
+        cv.wait(lock, [this]()
+                { return !pending; });
+        rethrow_error();
+        if (buffs[active].rows == 0)
+            return;
+        pending = true;
+        active ^= 1;
+        cv.notify_all();
+    }
+
+    bool due(const buffer &b) const
+    {
+        return b.rows != 0 && (b.rows >= opt.max_rows || b.bytes >= opt.max_bytes || std::chrono::steady_clock::now() - b.first >= opt.max_age);
+    }
+
+    template <size_t... I>
+    void insert_buffer(buffer &b, std::index_sequence<I...>)
+    {
+        clickhouse::Block block;
+        (block.AppendColumn(names[I], std::get<I>(b.cols)), ...);
+
+        auto start = std::chrono::steady_clock::now();
+        client.Insert(table, block);
+        uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        s_inserts++;
+        s_rows += b.rows;
+        s_last = us;
+        s_total += us;
+        if (us > s_max)
+            s_max = us;
+
+        if (b.src_us != UINT64_MAX)
+        {
+            uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            uint64_t e2e = now > b.src_us ? now - b.src_us : 0; // clocks of other hosts can be ahead
+            s_e2e_inserts++;
+            s_e2e_last = e2e;
+            s_e2e_total += e2e;
+            if (e2e > s_e2e_max)
+                s_e2e_max = e2e;
+        }
+    }
+
+    template <size_t... I>
+    void clear_buffer(buffer &b, std::index_sequence<I...>)
+    {
+        (std::get<I>(b.cols)->Clear(), ...);
+        b.rows = b.bytes = 0;
+        b.src_us = UINT64_MAX;
+    }
 
-    std::map<std::string, std::vector<std::pair<std::string, clickhouse::Column *>>> columns;
+    void insert_loop()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        while (1)
+        {
+            // wake up on a pending buffer, or max_age after the first row of the active buffer
+            // (an append to an empty buffer notifies, the deadline is then known)
+            if (buffs[active].rows == 0)
+                cv.wait(lock, [this]()
+                        { return pending || stop || buffs[active].rows != 0; });
+            else
+                cv.wait_until(lock, buffs[active].first + opt.max_age, [this]()
+                              { return pending || stop; });
 
-    void parse_query(std::string q, const std::string table_name);
+            if (!pending && due(buffs[active]))
+            {
+                pending = true;
+                active ^= 1;
+            }
 
-    template <class... T, class V>
-    void append_data(std::vector<std::pair<std::string, clickhouse::Column *>> *table, int iterator, V value);
-    template <class... T, class V>
-    void append_data(std::vector<std::pair<std::string, clickhouse::Column *>> *table, int iterator, V value, T... args);
+            if (pending)
+            {
+                buffer &b = buffs[active ^ 1];
+                std::exception_ptr e;
+                lock.unlock();
+                try
+                {
+                    insert_buffer(b, std::index_sequence_for<C...>());
+                }
+                catch (...)
+                {
+                    s_errors++;
+                    e = std::current_exception();
+                }
+                clear_buffer(b, std::index_sequence_for<C...>());
+                lock.lock();
+                if (e)
+                    error = e;
+                pending = false;
+                cv.notify_all();
+                continue;
+            }
+
+            if (stop)
+                break;
+        }
+    }
+
+public:
+    table_writer(const clickhouse::ClientOptions &cl_options, std::string table_name, std::array<std::string, col_count> column_names, const writer_options &options = writer_options())
+        : client(cl_options), table(std::move(table_name)), names(std::move(column_names)), opt(options)
+    {
+        th = std::thread([this]()
+                         { insert_loop(); });
+    }
+
+    table_writer(const table_writer &) = delete;
+    table_writer &operator=(const table_writer &) = delete;
+
+    // "name Type, name Type ..." for database::add_table
+    static std::string table_struct(const std::array<std::string, col_count> &column_names)
+    {
+        std::string q;
+        size_t i = 0;
+        ((q += (i ? ", " : "") + column_names[i] + " " + std::make_shared<C>()->Type()->GetName(), i++), ...);
+        return q;
+    }
+
+    // one value per column, in the order of C...
+    template <class... V>
+    void append(V &&...v)
+    {
+        append_timed(UINT64_MAX, std::forward<V>(v)...);
+    }
+
+    // same as append, src_us is the time the row was produced (us since epoch) for the e2e stats
+    template <class... V>
+    void append_timed(uint64_t src_us, V &&...v)
+    {
+        static_assert(sizeof...(V) == col_count, "append needs one value per column");
+
+        std::unique_lock<std::mutex> lock(m);
+        rethrow_error();
+
+        buffer &b = buffs[active];
+        size_t bytes = (value_bytes(v) + ...);
+        append_row(b, std::index_sequence_for<C...>(), std::forward<V>(v)...); // the buffer is unchanged if this throws
+
+        if (b.rows == 0)
+        {
+            b.first = std::chrono::steady_clock::now();
+            cv.notify_all(); // the inserter waits for the first row to start the max_age timer
+        }
+        if (src_us < b.src_us)
+            b.src_us = src_us;
+        b.bytes += bytes;
+        b.rows++;
+
+        if (b.rows >= opt.max_rows || b.bytes >= opt.max_bytes)
+            swap_locked(lock);
+    }
+
+    /*
+        bulk append of rows values per column : column I gets v_I[0, rows)
+        for structure-of-arrays sources (netflow_v5::flow_columns : pass rows and the .data() of each vector),
+        one lock for all the rows, the values are appended column by column
+    */
+    template <class... V>
+    void append_columns(size_t rows, const V *...v)
+    {
+        static_assert(sizeof...(V) == col_count, "append_columns needs one array per column");
+        if (rows == 0)
+            return;
+
+        std::unique_lock<std::mutex> lock(m);
+        rethrow_error();
+
+        buffer &b = buffs[active];
+        size_t bytes = (column_bytes(v, rows) + ...);
+        append_bulk(b, std::index_sequence_for<C...>(), rows, v...);
+
+        if (b.rows == 0)
+        {
+            b.first = std::chrono::steady_clock::now();
+            cv.notify_all(); // the inserter waits for the first row to start the max_age timer
+        }
+        b.bytes += bytes;
+        b.rows += rows;
+
+        if (b.rows >= opt.max_rows || b.bytes >= opt.max_bytes)
+            swap_locked(lock);
+    }
+
+    // send the active buffer now and wait until it is inserted
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        swap_locked(lock);
+        cv.wait(lock, [this]()
+                { return !pending; });
+        rethrow_error();
+    }
+
+    writer_stats stats() const
+    {
+        writer_stats st;
+        st.inserts = s_inserts;
+        st.rows = s_rows;
+        st.errors = s_errors;
+        st.last_latency_us = s_last;
+        st.max_latency_us = s_max;
+        st.total_latency_us = s_total;
+        st.e2e_inserts = s_e2e_inserts;
+        st.last_e2e_us = s_e2e_last;
+        st.max_e2e_us = s_e2e_max;
+        st.total_e2e_us = s_e2e_total;
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - created).count();
+        st.rows_per_s = sec > 0 ? st.rows / sec : 0;
+        return st;
+    }
+
+    // inserts what is left, insert errors are lost here (call flush() before to get them)
+    ~table_writer()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [this]()
+                    { return !pending; });
+            if (buffs[active].rows != 0)
+            {
+                pending = true;
+                active ^= 1;
+            }
+            stop = true;
+            cv.notify_all();
+        }
+        th.join();
+    }
+};
+
+class database
+{
+private:
+    clickhouse::ClientOptions cl_options;
+    clickhouse::Client client;
 
 public:
     /**
@@ -35,12 +409,14 @@ public:
     void add_table(const std::string table_name, const std::string table_struct_querry, const std::string engine);
 
     /**
-     * append by list from query
+     * typed writer for table_name, column_names in the order of C...
+     * the writer has its own connection, so one writer per thread does not share anything
      */
-    template <class... T>
-    void append(const std::string table_name, T... args);
-
-    void insert(const std::string table_name);
+    template <class... C>
+    std::unique_ptr<table_writer<C...>> make_writer(const std::string table_name, std::array<std::string, sizeof...(C)> column_names, const writer_options &opt = writer_options())
+    {
+        return std::make_unique<table_writer<C...>>(cl_options, table_name, std::move(column_names), opt);
+    }
 
-    ~database();
-};
\ No newline at end of file
+    ~database() = default;
+};
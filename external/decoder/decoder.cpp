@@ -0,0 +1,143 @@
+#include "decoder.h"
+#include "../protobuff/gen/pack_v2.pb.h"
+
+#include <cstring>
+#include <netinet/in.h>
+#include <net/ethernet.h>
+#include <google/protobuf/arena.h>
+
+// unaligned loads straight from the capture buffer
+static inline uint16_t load_be16(const u_char *p) { return (uint16_t(p[0]) << 8) | p[1]; }
+static inline uint32_t load_be32(const u_char *p) { return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]; }
+static inline uint64_t load_mac(const u_char *p) { return (uint64_t(load_be16(p)) << 32) | load_be32(p + 2); }
+
+bool decode_pack(const u_char *data, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, decoded_pack &out)
+{
+    static constexpr uint32_t ip6_hlen = 40, tcp_hlen = 20, udp_hlen = 8;
+
+    if (cap < ETH_HLEN)
+        return false;
+
+    out.time_us = uint64_t(tv_sec) * 1000000 + tv_usec;
+    out.frame_size = len;
+    out.d_mac = load_mac(data);
+    out.s_mac = load_mac(data + ETH_ALEN);
+    out.ipv = 0;
+    out.s_ip4 = out.d_ip4 = 0;
+    out.proto = t_proto::UNDEFINED;
+    out.s_port = out.d_port = 0;
+    out.tcp_flags = 0;
+
+    uint32_t index = ETH_HLEN;
+    uint16_t ether_type = load_be16(data + 12);
+
+    // 802.1Q / 802.1ad tags
+    while ((ether_type == ETHERTYPE_VLAN || ether_type == 0x88a8) && cap >= index + 4)
+    {
+        ether_type = load_be16(data + index + 2);
+        index += 4;
+    }
+
+    uint8_t next;
+    switch (ether_type)
+    {
+    case ETHERTYPE_IP:
+        {
+            if (cap < index + 20)
+                return true;
+            const u_char *iph = data + index;
+            uint32_t ihl = (iph[0] & 0x0f) * 4;
+            if (ihl < 20 || cap < index + ihl)
+                return true;
+
+            out.ipv = 4;
+            out.s_ip4 = load_be32(iph + 12);
+            out.d_ip4 = load_be32(iph + 16);
+            next = iph[9];
+
+            // only the first fragment has the transport header
+            if ((load_be16(iph + 6) & 0x1fff) != 0)
+                return true;
+            index += ihl;
+        }
+        break;
+
+    case ETHERTYPE_IPV6:
+        {
+            if (cap < index + ip6_hlen)
+                return true;
+            const u_char *iph = data + index;
+
+            out.ipv = 6;
+            std::memcpy(out.s_ip6, iph + 8, 16);
+            std::memcpy(out.d_ip6, iph + 24, 16);
+            next = iph[6];
+            index += ip6_hlen;
+        }
+        break;
+
+    default:
+        return true;
+    }
+
+    switch (next)
+    {
+    case IPPROTO_TCP:
+        out.proto = t_proto::TCP;
+        if (cap < index + tcp_hlen)
+            return true;
+        out.s_port = load_be16(data + index);
+        out.d_port = load_be16(data + index + 2);
+        out.tcp_flags = data[index + 13];
+        break;
+
+    case IPPROTO_UDP:
+        out.proto = t_proto::UDP;
+        if (cap < index + udp_hlen)
+            return true;
+        out.s_port = load_be16(data + index);
+        out.d_port = load_be16(data + index + 2);
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+void to_proto(const decoded_pack &p, pack_v2 *msg)
+{
+    msg->Clear(); // keeps the capacity of the bytes fields
+
+    msg->set_time(p.time_us);
+    msg->set_framesize(p.frame_size);
+
+    u_char macs[12];
+    for (int i = 0; i < 6; i++)
+    {
+        macs[i] = p.s_mac >> (40 - 8 * i);
+        macs[6 + i] = p.d_mac >> (40 - 8 * i);
+    }
+    msg->set_macs(macs, sizeof(macs));
+
+    msg->set_ipv(p.ipv);
+    if (p.ipv == 4)
+    {
+        msg->set_s_ip4(p.s_ip4);
+        msg->set_d_ip4(p.d_ip4);
+    }
+    else if (p.ipv == 6)
+    {
+        msg->set_s_ip6(p.s_ip6, sizeof(p.s_ip6));
+        msg->set_d_ip6(p.d_ip6, sizeof(p.d_ip6));
+    }
+
+    msg->set_t_proto(static_cast<transport>(p.proto));
+    msg->set_ports((uint32_t(p.s_port) << 16) | p.d_port);
+}
+
+pack_v2 *new_pack_v2(google::protobuf::Arena *arena)
+{
+    return google::protobuf::Arena::CreateMessage<pack_v2>(arena);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/*
+    zero-copy header decoder : reads ethernet/ip/ip6/tcp/udp headers in place from the capture buffer
+    nothing is allocated, the result is a fixed-layout struct (decoded_pack)
+    every read is checked against caplen, truncated frames are decoded as far as possible
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <sys/types.h>
+
+namespace google::protobuf { class Arena; }
+class pack_v2;
+
+enum class t_proto : uint8_t
+{
+    UNDEFINED = 0,
+    TCP = 6, // IPPROTO_TCP
+    UDP = 17 // IPPROTO_UDP
+};
+
+struct decoded_pack
+{
+    uint64_t time_us;           // tv_sec * 1000000 + tv_usec
+    uint32_t frame_size;
+    uint64_t s_mac, d_mac;      // 48 bit, first byte of the address is the most significant
+    uint8_t ipv;                // 0 -> not ip
+    uint32_t s_ip4, d_ip4;      // host byte order, only for ipv == 4
+    uint8_t s_ip6[16], d_ip6[16]; // network byte order, only for ipv == 6
+    t_proto proto;
+    uint16_t s_port, d_port;    // host byte order
+    uint8_t tcp_flags;
+};
+
+/**
+ * @return false if the frame is shorter than an ethernet header (out is left unchanged)
+ */
+bool decode_pack(const u_char *data, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, decoded_pack &out);
+
+// fill message (cleared first) from decoded_pack, message can be reused -> no allocations after the first ip6 frame
+void to_proto(const decoded_pack &p, pack_v2 *msg);
+
+// message created on the arena (destroyed together with the arena)
+pack_v2 *new_pack_v2(google::protobuf::Arena *arena);
@@ -0,0 +1,255 @@
+#include "flow_table.h"
+#include "../protobuff/gen/pack_v2.pb.h"
+
+#include <bit>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <netinet/tcp.h>
+
+flow_table::flow_table(std::function<void(const flow_record &)> on_flow, const flow_table_options &options)
+    : opt(options), emit(std::move(on_flow))
+{
+    if (opt.capacity < 2 || opt.max_load <= 0 || opt.max_load >= 1)
+        throw std::invalid_argument("invalid flow_table_options");
+
+    slots.resize(std::bit_ceil(opt.capacity));
+    mask = slots.size() - 1;
+    limit = std::max<size_t>(1, slots.size() * opt.max_load);
+    for (auto &s : slots)
+    {
+        s.hash = 0;
+    }
+}
+
+uint32_t flow_table::hash_key(const flow_key &k)
+{
+    // FNV-1a over the key, 0 is reserved for empty slots
+    uint32_t h = 2166136261u;
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(&k);
+    for (size_t i = 0; i < sizeof(flow_key); i++)
+    {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h == 0 ? 1 : h;
+}
+
+flow_key flow_table::make_key(const decoded_pack &p)
+{
+    flow_key k;
+    std::memset(&k, 0, sizeof(k)); // padding takes part in the hash
+    if (p.ipv == 4)
+    {
+        std::memcpy(k.s_ip, &p.s_ip4, 4);
+        std::memcpy(k.d_ip, &p.d_ip4, 4);
+    }
+    else
+    {
+        std::memcpy(k.s_ip, p.s_ip6, 16);
+        std::memcpy(k.d_ip, p.d_ip6, 16);
+    }
+    k.s_port = p.s_port;
+    k.d_port = p.d_port;
+    k.proto = static_cast<uint8_t>(p.proto);
+    k.ipv = p.ipv;
+    return k;
+}
+
+bool flow_table::evict(size_t i, flow_record::end_reason reason)
+{
+    slot &s = slots[i];
+
+    flow_record r;
+    std::memset(&r.v5, 0, sizeof(r.v5));
+    r.key = s.key;
+    r.packets = s.packets;
+    r.bytes = s.bytes;
+    r.first_us = s.first_us;
+    r.last_us = s.last_us;
+    r.tcp_flags = s.tcp_flags;
+    r.reason = reason;
+
+    if (s.key.ipv == 4)
+    {
+        std::memcpy(&r.v5.srcaddr, s.key.s_ip, 4);
+        std::memcpy(&r.v5.dstaddr, s.key.d_ip, 4);
+    }
+    r.v5.dPkts = std::min<uint64_t>(s.packets, UINT32_MAX);
+    r.v5.dOctets = std::min<uint64_t>(s.bytes, UINT32_MAX);
+    r.v5.first = (s.first_us - start_us) / 1000;
+    r.v5.last = (s.last_us - start_us) / 1000;
+    r.v5.srcport = s.key.s_port;
+    r.v5.dstport = s.key.d_port;
+    r.v5.tcp_flags = s.tcp_flags;
+    r.v5.prot = s.key.proto;
+
+    switch (reason)
+    {
+    case flow_record::IDLE: st.idle++; break;
+    case flow_record::ACTIVE: st.active++; break;
+    case flow_record::FIN_RST: st.fin_rst++; break;
+    case flow_record::PRESSURE: st.pressure++; break;
+    case flow_record::FLUSH: st.flushed++; break;
+    }
+
+    emit(r);
+
+    // backward-shift delete : move later entries of the cluster into the hole
+    size--;
+    bool moved = false;
+    size_t hole = i;
+    for (size_t j = (i + 1) & mask; slots[j].hash != 0; j = (j + 1) & mask)
+    {
+        size_t home = slots[j].hash & mask;
+        // j can fill the hole if its home is not in (hole, j]
+        if (((j - home) & mask) >= ((j - hole) & mask))
+        {
+            slots[hole] = slots[j];
+            if (hole == i)
+                moved = true;
+            hole = j;
+        }
+    }
+    slots[hole].hash = 0;
+    return moved;
+}
+
+// full table : evict the least recently seen flow among the first occupied slots from home
+void flow_table::pressure_evict(size_t home)
+{
+    static constexpr size_t window = 8;
+    size_t oldest = SIZE_MAX;
+    for (size_t n = 0, i = home; n < window || oldest == SIZE_MAX; n++, i = (i + 1) & mask)
+    {
+        if (slots[i].hash != 0 && (oldest == SIZE_MAX || slots[i].last_us < slots[oldest].last_us))
+            oldest = i;
+    }
+    evict(oldest, flow_record::PRESSURE);
+}
+
+void flow_table::sweep(uint64_t now_us, size_t n)
+{
+    for (size_t k = 0; k < n && size != 0; k++)
+    {
+        slot &s = slots[sweep_pos];
+        if (s.hash != 0)
+        {
+            if (now_us - s.last_us >= opt.idle_timeout_us && now_us > s.last_us)
+            {
+                if (evict(sweep_pos, flow_record::IDLE))
+                    continue; // check the moved entry at the same position
+            }
+            else if (now_us - s.first_us >= opt.active_timeout_us && now_us > s.first_us)
+            {
+                if (evict(sweep_pos, flow_record::ACTIVE))
+                    continue;
+            }
+        }
+        sweep_pos = (sweep_pos + 1) & mask;
+    }
+}
+
+void flow_table::add(const decoded_pack &p)
+{
+    if (p.ipv == 0)
+    {
+        st.ignored++;
+        return;
+    }
+    st.packets++;
+    if (start_us == 0)
+        start_us = p.time_us;
+
+    sweep(p.time_us, opt.sweep_per_packet);
+
+    flow_key k = make_key(p);
+    uint32_t h = hash_key(k);
+    size_t i = h & mask, probe = 0;
+
+    while (slots[i].hash != 0 && !(slots[i].hash == h && slots[i].key == k))
+    {
+        i = (i + 1) & mask;
+        probe++;
+    }
+    st.max_probe = std::max(st.max_probe, probe);
+
+    if (slots[i].hash == 0)
+    {
+        if (size >= limit)
+        {
+            pressure_evict(h & mask);
+            // the probe sequence changed, look for the free slot again
+            for (i = h & mask; slots[i].hash != 0; i = (i + 1) & mask)
+                ;
+        }
+
+        slot &s = slots[i];
+        s.hash = h;
+        s.key = k;
+        s.packets = s.bytes = 0;
+        s.first_us = p.time_us;
+        s.tcp_flags = 0;
+        size++;
+        st.created++;
+        st.max_size = std::max(st.max_size, size);
+    }
+
+    slot &s = slots[i];
+    s.packets++;
+    s.bytes += p.frame_size;
+    s.last_us = p.time_us;
+    s.tcp_flags |= p.tcp_flags;
+
+    if (p.proto == t_proto::TCP && (p.tcp_flags & (TH_FIN | TH_RST)))
+        evict(i, flow_record::FIN_RST);
+}
+
+void flow_table::expire(uint64_t now_us)
+{
+    sweep(now_us, slots.size() + size);
+}
+
+void flow_table::flush()
+{
+    for (size_t i = 0; i < slots.size() && size != 0;)
+    {
+        if (slots[i].hash != 0 && evict(i, flow_record::FLUSH))
+            continue;
+        i++;
+    }
+}
+
+flow_table_stats flow_table::stats() const
+{
+    flow_table_stats s = st;
+    s.size = size;
+    s.capacity = slots.size();
+    return s;
+}
+
+void to_proto(const flow_record &r, flow_v2 *msg)
+{
+    msg->Clear();
+
+    msg->set_first(r.first_us);
+    msg->set_last(r.last_us);
+    msg->set_packets(r.packets);
+    msg->set_bytes(r.bytes);
+    msg->set_ipv(r.key.ipv);
+
+    if (r.key.ipv == 4)
+    {
+        msg->set_s_ip4(r.v5.srcaddr);
+        msg->set_d_ip4(r.v5.dstaddr);
+    }
+    else
+    {
+        msg->set_s_ip6(r.key.s_ip, sizeof(r.key.s_ip));
+        msg->set_d_ip6(r.key.d_ip, sizeof(r.key.d_ip));
+    }
+
+    msg->set_t_proto(static_cast<transport>(r.key.proto));
+    msg->set_ports((uint32_t(r.key.s_port) << 16) | r.key.d_port);
+    msg->set_tcp_flags(r.tcp_flags);
+    msg->set_end_reason(r.reason);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+    5-tuple flow aggregation for the capture client
+    open addressing (linear probing, backward-shift delete) over one flat array, no locks :
+    use one flow_table per capture thread
+    flows are emitted through the callback on idle/active timeout, TCP FIN/RST, table pressure or flush()
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+#include "../decoder/decoder.h"
+#include "../netflow_parser/netflow.hpp"
+
+class flow_v2;
+
+struct flow_key
+{
+    uint8_t s_ip[16], d_ip[16]; // IPv4 -> first 4 bytes (host byte order), rest 0
+    uint16_t s_port, d_port;
+    uint8_t proto, ipv;
+
+    bool operator==(const flow_key &) const = default;
+};
+
+struct flow_record
+{
+    enum end_reason : uint8_t
+    {
+        IDLE,
+        ACTIVE,
+        FIN_RST,
+        PRESSURE,
+        FLUSH
+    };
+
+    // v5 shaped record : addresses for IPv4, dPkts/dOctets saturated to 32 bit,
+    // first/last in ms since the table was created (like sysUptime)
+    netflow_v5::FlowRecord v5;
+
+    flow_key key;
+    uint64_t packets, bytes;
+    uint64_t first_us, last_us; // capture time
+    uint8_t tcp_flags;          // OR of all packets
+    end_reason reason;
+};
+
+struct flow_table_options
+{
+    size_t capacity = 1 << 16;    // slots, rounded up to a power of 2
+    double max_load = 0.75;       // above this the oldest flow of the probe window is evicted
+    uint64_t idle_timeout_us = 15 * 1000000ull;
+    uint64_t active_timeout_us = 60 * 1000000ull;
+    size_t sweep_per_packet = 4;  // slots checked for timeouts on every packet
+};
+
+struct flow_table_stats
+{
+    uint64_t packets = 0, ignored = 0, created = 0;
+    uint64_t idle = 0, active = 0, fin_rst = 0, pressure = 0, flushed = 0;
+    size_t size = 0, capacity = 0, max_size = 0, max_probe = 0;
+};
+
+class flow_table
+{
+private:
+    struct slot
+    {
+        uint32_t hash; // 0 -> empty
+        uint8_t tcp_flags;
+        flow_key key;
+        uint64_t packets, bytes, first_us, last_us;
+    };
+
+    std::vector<slot> slots;
+    size_t mask, size = 0, limit, sweep_pos = 0;
+    flow_table_options opt;
+    flow_table_stats st;
+    uint64_t start_us = 0; // time of the first packet, base of v5 first/last
+
+    std::function<void(const flow_record &)> emit;
+
+    static uint32_t hash_key(const flow_key &k);
+    static flow_key make_key(const decoded_pack &p);
+
+    // emits slot i and removes it (backward shift), returns true if an entry was moved into i
+    bool evict(size_t i, flow_record::end_reason reason);
+    void pressure_evict(size_t home);
+    void sweep(uint64_t now_us, size_t n);
+
+public:
+    flow_table(std::function<void(const flow_record &)> on_flow, const flow_table_options &options = flow_table_options());
+
+    // packets without IP are ignored
+    void add(const decoded_pack &p);
+
+    // evicts flows idle/active at now_us (call it when no packets arrive)
+    void expire(uint64_t now_us);
+
+    // emits every flow
+    void flush();
+
+    flow_table_stats stats() const;
+
+    ~flow_table() = default;
+};
+
+// fill message (cleared first) from flow_record
+void to_proto(const flow_record &r, flow_v2 *msg);
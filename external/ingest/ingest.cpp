@@ -0,0 +1,256 @@
+#include "ingest.h"
+#include "../protobuff/gen/pack_v2.pb.h"
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+const std::array<std::string, 12> ingest_server::pack_columns = {
+    "time_us", "frame_size", "s_mac", "d_mac", "ipv", "s_ip4", "d_ip4", "s_ip6", "d_ip6", "proto", "s_port", "d_port"};
+
+const std::array<std::string, 14> ingest_server::flow_columns = {
+    "first_us", "last_us", "packets", "bytes", "ipv", "s_ip4", "d_ip4", "s_ip6", "d_ip6", "proto", "s_port", "d_port", "tcp_flags", "end_reason"};
+
+static uint64_t now_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// ColumnIPv6::Append(string_view) parses text : pass the 16 raw bytes as in6_addr, zero (::) for IPv4 rows
+static in6_addr ip6(const std::string &s)
+{
+    in6_addr a = {};
+    if (s.size() == 16)
+        std::memcpy(&a, s.data(), 16);
+    return a;
+}
+
+// 6 bytes, network order -> 48 bit number
+static uint64_t mac48(const std::string &macs, size_t off)
+{
+    uint64_t v = 0;
+    for (size_t i = off; i < off + 6 && i < macs.size(); i++)
+    {
+        v = (v << 8) | static_cast<uint8_t>(macs[i]);
+    }
+    return v;
+}
+
+// column types are deduced from the writer pointer
+template <class... C>
+static void make_writer(database &db, std::unique_ptr<table_writer<C...>> &w, const std::string &table, const std::array<std::string, sizeof...(C)> &names, const writer_options &opt)
+{
+    w = db.make_writer<C...>(table, names, opt);
+}
+
+ingest_server::worker::worker(const ingest_options &o) : opt(o)
+{
+    new_messages();
+}
+
+void ingest_server::worker::new_messages()
+{
+    packs = google::protobuf::Arena::CreateMessage<pack_batch>(&arena);
+    flows = google::protobuf::Arena::CreateMessage<flow_batch>(&arena);
+}
+
+void ingest_server::worker::on_msg(const char *data, int len)
+{
+    uint64_t recv = now_us();
+    messages.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(len, std::memory_order_relaxed);
+
+    uint64_t sent = 0;
+    size_t n = 0;
+    try
+    {
+        if (opt.kind == ingest_options::PACKS)
+        {
+            if (!packs->ParseFromArray(data, len))
+            {
+                bad.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            sent = packs->sent();
+            for (const pack_v2 &p : packs->packs())
+            {
+                // ColumnIPv4 takes network byte order, pack_v2 keeps host order
+                pw->append_timed(sent ? sent : p.time(), p.time(), p.framesize(), mac48(p.macs(), 0), mac48(p.macs(), 6), static_cast<uint8_t>(p.ipv()),
+                                 htonl(p.s_ip4()), htonl(p.d_ip4()), ip6(p.s_ip6()), ip6(p.d_ip6()),
+                                 static_cast<uint8_t>(p.t_proto()), static_cast<uint16_t>(p.ports() >> 16), static_cast<uint16_t>(p.ports()));
+            }
+            n = packs->packs_size();
+        }
+        else
+        {
+            if (!flows->ParseFromArray(data, len))
+            {
+                bad.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            sent = flows->sent();
+            for (const flow_v2 &f : flows->flows())
+            {
+                fw->append_timed(sent ? sent : f.last(), f.first(), f.last(), f.packets(), f.bytes(), static_cast<uint8_t>(f.ipv()),
+                                 htonl(f.s_ip4()), htonl(f.d_ip4()), ip6(f.s_ip6()), ip6(f.d_ip6()),
+                                 static_cast<uint8_t>(f.t_proto()), static_cast<uint16_t>(f.ports() >> 16), static_cast<uint16_t>(f.ports()),
+                                 static_cast<uint8_t>(f.tcp_flags()), static_cast<uint8_t>(f.end_reason()));
+            }
+            n = flows->flows_size();
+        }
+    }
+    catch (const std::exception &e)
+    {
+        // a failed insert is reported once by the next append, the rows of that buffer are lost
+        errors.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "ingest: " << e.what() << std::endl;
+    }
+    records.fetch_add(n, std::memory_order_relaxed);
+
+    if (sent != 0)
+    {
+        uint64_t lat = recv > sent ? recv - sent : 0;
+        lat_count.fetch_add(1, std::memory_order_relaxed);
+        lat_total.fetch_add(lat, std::memory_order_relaxed);
+        if (lat > lat_max.load(std::memory_order_relaxed))
+            lat_max.store(lat, std::memory_order_relaxed);
+    }
+
+    // parsed messages reuse their cleared elements, the arena only grows with bigger batches
+    if (arena.SpaceUsed() > opt.arena_limit)
+    {
+        arena.Reset();
+        new_messages();
+    }
+}
+
+void ingest_server::worker::flush()
+{
+    if (pw)
+        pw->flush();
+    if (fw)
+        fw->flush();
+}
+
+writer_stats ingest_server::worker::wstats() const
+{
+    return pw ? pw->stats() : fw->stats();
+}
+
+std::string ingest_server::table_struct(ingest_options::kind_t kind)
+{
+    return kind == ingest_options::PACKS ? pack_writer::table_struct(pack_columns) : flow_writer::table_struct(flow_columns);
+}
+
+ingest_server::ingest_server(database &db, nats_client &client, const ingest_options &options)
+    : nc(client), opt(options)
+{
+    if (opt.workers == 0)
+        throw std::invalid_argument("ingest_options::workers must be > 0");
+
+    const std::string &order = opt.kind == ingest_options::PACKS ? pack_columns[0] : flow_columns[0];
+    db.add_table(opt.table, table_struct(opt.kind), opt.engine.empty() ? "MergeTree ORDER BY " + order : opt.engine);
+
+    for (uint32_t i = 0; i < opt.workers; i++)
+    {
+        auto w = std::make_unique<worker>(opt);
+        if (opt.kind == ingest_options::PACKS)
+            make_writer(db, w->pw, opt.table, pack_columns, opt.writer);
+        else
+            make_writer(db, w->fw, opt.table, flow_columns, opt.writer);
+        workers.push_back(std::move(w));
+    }
+
+    // subscribe only when every worker is ready
+    try
+    {
+        for (auto &w : workers)
+        {
+            worker *p = w.get();
+            nc.nats_client_queue_subscribe(opt.subject.c_str(), opt.queue.c_str(), [p](const char *data, int len)
+                                           { p->on_msg(data, len); });
+        }
+    }
+    catch (...)
+    {
+        nc.nats_client_close_queues(); // the subscriptions made so far call into workers freed by the throw
+        throw;
+    }
+}
+
+void ingest_server::drain(int64_t timeout_ms)
+{
+    if (drained)
+        return;
+    drained = true;
+    try
+    {
+        nc.nats_client_drain(timeout_ms);
+    }
+    catch (...)
+    {
+        // the subscriptions are still delivering : stop them before the workers can be freed
+        nc.nats_client_close_queues();
+        throw;
+    }
+    for (auto &w : workers)
+    {
+        w->flush();
+    }
+}
+
+ingest_server::~ingest_server()
+{
+    try
+    {
+        drain();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "ingest: " << e.what() << std::endl;
+    }
+}
+
+ingest_stats ingest_server::stats() const
+{
+    ingest_stats st;
+    uint64_t lat_count = 0, lat_total = 0;
+
+    for (auto &w : workers)
+    {
+        st.messages += w->messages.load(std::memory_order_relaxed);
+        st.records += w->records.load(std::memory_order_relaxed);
+        st.bytes += w->bytes.load(std::memory_order_relaxed);
+        st.bad += w->bad.load(std::memory_order_relaxed);
+        st.insert_errors += w->errors.load(std::memory_order_relaxed);
+        lat_count += w->lat_count.load(std::memory_order_relaxed);
+        lat_total += w->lat_total.load(std::memory_order_relaxed);
+        st.recv_latency_max_us = std::max(st.recv_latency_max_us, w->lat_max.load(std::memory_order_relaxed));
+
+        writer_stats ws = w->wstats();
+        st.writer.inserts += ws.inserts;
+        st.writer.rows += ws.rows;
+        st.writer.errors += ws.errors;
+        st.writer.last_latency_us = std::max(st.writer.last_latency_us, ws.last_latency_us);
+        st.writer.max_latency_us = std::max(st.writer.max_latency_us, ws.max_latency_us);
+        st.writer.total_latency_us += ws.total_latency_us;
+        st.writer.rows_per_s += ws.rows_per_s;
+        st.writer.e2e_inserts += ws.e2e_inserts;
+        st.writer.last_e2e_us = std::max(st.writer.last_e2e_us, ws.last_e2e_us);
+        st.writer.max_e2e_us = std::max(st.writer.max_e2e_us, ws.max_e2e_us);
+        st.writer.total_e2e_us += ws.total_e2e_us;
+    }
+
+    st.dropped = nc.subscription_dropped();
+    st.recv_latency_avg_us = lat_count ? double(lat_total) / lat_count : 0;
+    st.e2e_avg_us = st.writer.e2e_inserts ? double(st.writer.total_e2e_us) / st.writer.e2e_inserts : 0;
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    st.messages_per_s = sec > 0 ? st.messages / sec : 0;
+    st.records_per_s = sec > 0 ? st.records / sec : 0;
+    return st;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+    nats -> clickhouse ingest for the batches published by the client (nats_client async mode)
+    every worker is one queue group subscription (own delivery thread) with its own protobuf Arena
+    and its own table_writer (own clickhouse connection) : workers share nothing on the hot path
+    several server processes with the same queue name split the subject between them
+*/
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <chrono>
+
+#include <google/protobuf/arena.h>
+#include <clickhouse/client.h>
+
+#include "../database/db.h"
+#include "../nats-client/nc.h"
+
+class pack_batch;
+class flow_batch;
+
+struct ingest_options
+{
+    enum kind_t
+    {
+        PACKS, // pack_batch of pack_v2 (client without aggregation, "sniff.base")
+        FLOWS  // flow_batch of flow_v2 (client with aggregation, "sniff.flows")
+    };
+
+    kind_t kind = PACKS;
+    std::string subject = "sniff.base", queue = "sniff.ingest";
+    std::string table = "packs";
+    std::string engine; // empty -> MergeTree ordered by the first (time) column
+    uint32_t workers = 4;
+    size_t arena_limit = 64 * 1024 * 1024; // the worker arena is reset above this
+    writer_options writer;
+};
+
+struct ingest_stats
+{
+    uint64_t messages = 0, records = 0, bytes = 0, bad = 0, dropped = 0; // dropped -> nats slow consumer
+    uint64_t insert_errors = 0;                                           // append errors (see stderr)
+    // publish (batch sent) -> message received by a worker
+    uint64_t recv_latency_max_us = 0;
+    double recv_latency_avg_us = 0;
+    // publish -> rows inserted (oldest row of every insert), max in writer.max_e2e_us
+    double e2e_avg_us = 0;
+    writer_stats writer; // summed over the workers (last/max latencies -> max)
+    double messages_per_s = 0, records_per_s = 0;
+};
+
+class ingest_server
+{
+private:
+    using pack_writer = table_writer<clickhouse::ColumnUInt64, clickhouse::ColumnUInt32, clickhouse::ColumnUInt64, clickhouse::ColumnUInt64, clickhouse::ColumnUInt8,
+                                     clickhouse::ColumnIPv4, clickhouse::ColumnIPv4, clickhouse::ColumnIPv6, clickhouse::ColumnIPv6,
+                                     clickhouse::ColumnUInt8, clickhouse::ColumnUInt16, clickhouse::ColumnUInt16>;
+    using flow_writer = table_writer<clickhouse::ColumnUInt64, clickhouse::ColumnUInt64, clickhouse::ColumnUInt64, clickhouse::ColumnUInt64, clickhouse::ColumnUInt8,
+                                     clickhouse::ColumnIPv4, clickhouse::ColumnIPv4, clickhouse::ColumnIPv6, clickhouse::ColumnIPv6,
+                                     clickhouse::ColumnUInt8, clickhouse::ColumnUInt16, clickhouse::ColumnUInt16, clickhouse::ColumnUInt8, clickhouse::ColumnUInt8>;
+
+    static const std::array<std::string, 12> pack_columns;
+    static const std::array<std::string, 14> flow_columns;
+
+    // only touched by the delivery thread of its subscription, counters are read by stats()
+    struct worker
+    {
+        const ingest_options &opt;
+        google::protobuf::Arena arena;
+        pack_batch *packs = nullptr;
+        flow_batch *flows = nullptr;
+        std::unique_ptr<pack_writer> pw;
+        std::unique_ptr<flow_writer> fw;
+
+        std::atomic<uint64_t> messages{0}, records{0}, bytes{0}, bad{0}, errors{0};
+        std::atomic<uint64_t> lat_count{0}, lat_total{0}, lat_max{0};
+
+        explicit worker(const ingest_options &o);
+
+        void new_messages();
+        void on_msg(const char *data, int len);
+        void flush();
+        writer_stats wstats() const;
+    };
+
+    nats_client &nc;
+    const ingest_options opt;
+    std::vector<std::unique_ptr<worker>> workers;
+    bool drained = false;
+    const std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+public:
+    // creates the table (if needed), the writers, and subscribes every worker
+    ingest_server(database &db, nats_client &client, const ingest_options &options = ingest_options());
+
+    ingest_server(const ingest_server &) = delete;
+    ingest_server &operator=(const ingest_server &) = delete;
+
+    /*
+        graceful stop : drain the subscriptions, then insert what the writers still hold
+        on a drain error (timeout) the subscriptions are closed, the messages not handled yet are lost
+        and the error is thrown
+    */
+    void drain(int64_t timeout_ms = 10000);
+
+    ingest_stats stats() const;
+
+    static std::string table_struct(ingest_options::kind_t kind);
+
+    // drains if drain() was not called (errors are lost)
+    ~ingest_server();
+};
@@ -3,10 +3,19 @@
 #include <iostream>
 #include <functional>
 #include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <cstring>
+#include <bit>
 #include <nats/nats.h>
 
 nats_client::~nats_client()
 {
+    stop_async();
+    for (natsSubscription *q : q_subs)
+    {
+        natsSubscription_Destroy(q);
+    }
     natsSubscription_Destroy(sub);
     natsConnection_Close(con);
     natsConnection_Destroy(con);
@@ -14,25 +23,346 @@ nats_client::~nats_client()
 
 void nats_client::nats_client_connect()
 {
-    natsConnection_ConnectTo(&con, NATS_DEFAULT_URL);
+    natsStatus s = natsConnection_ConnectTo(&con, NATS_DEFAULT_URL);
+    if (s != NATS_OK)
+    {
+        throw std::runtime_error(std::string("nats connect error: ") + natsStatus_GetText(s));
+    }
 }
 
 // handler function for natsConnection_Subscribe(...) [call another handler function<void(const char*, int)> (for database)]
-void onMsg(natsConnection *nc, natsSubscription *sub, natsMsg *msg, void *closure)
+void onMsg(natsConnection *, natsSubscription *, natsMsg *msg, void *)
 {
     nats_client::Hfunc(natsMsg_GetData(msg), natsMsg_GetDataLength(msg));
     natsMsg_Destroy(msg);
 }
 
-void nats_client::nats_client_subscribe(const char const *subject)
+void nats_client::nats_client_subscribe(const char *subject)
 {
     natsConnection_Subscribe(&sub, con, subject, onMsg, NULL);
 }
 
-void nats_client::nats_send_data(const void *data, int len, const char const *subject)
+// handler for the queue subscriptions, closure -> the handler of that subscription
+static void on_queue_msg(natsConnection *, natsSubscription *, natsMsg *msg, void *closure)
+{
+    (*static_cast<std::function<void(const char *, int)> *>(closure))(natsMsg_GetData(msg), natsMsg_GetDataLength(msg));
+    natsMsg_Destroy(msg);
+}
+
+void nats_client::nats_client_queue_subscribe(const char *subject, const char *queue, std::function<void(const char *, int)> h)
+{
+    q_handlers.push_back(std::move(h));
+    natsSubscription *q = NULL;
+    natsStatus s = natsConnection_QueueSubscribe(&q, con, subject, queue, on_queue_msg, &q_handlers.back());
+    if (s != NATS_OK)
+    {
+        q_handlers.pop_back();
+        throw std::runtime_error(std::string("nats queue subscribe error: ") + natsStatus_GetText(s));
+    }
+    q_subs.push_back(q);
+
+    // called by the delivery thread when it ends (drained or unsubscribed)
+    s = natsSubscription_SetOnCompleteCB(q, on_queue_complete, this);
+    if (s != NATS_OK)
+    {
+        std::lock_guard<std::mutex> lock(q_mutex);
+        q_done++; // nothing to wait for in nats_client_close_queues
+        throw std::runtime_error(std::string("nats queue subscribe error: ") + natsStatus_GetText(s));
+    }
+}
+
+void nats_client::on_queue_complete(void *closure)
+{
+    nats_client *nc = static_cast<nats_client *>(closure);
+    std::lock_guard<std::mutex> lock(nc->q_mutex);
+    nc->q_done++;
+    nc->q_cv.notify_all();
+}
+
+void nats_client::nats_client_drain(int64_t timeout_ms)
+{
+    // first stop every subscription, then wait : the members drain at the same time
+    for (natsSubscription *q : q_subs)
+    {
+        natsSubscription_Drain(q);
+    }
+    for (natsSubscription *q : q_subs)
+    {
+        natsStatus s = natsSubscription_WaitForDrainCompletion(q, timeout_ms);
+        if (s != NATS_OK)
+            throw std::runtime_error(std::string("nats drain error: ") + natsStatus_GetText(s));
+    }
+}
+
+void nats_client::nats_client_close_queues()
+{
+    // fails for the subscriptions already closed (drained), their delivery thread has ended or is ending
+    for (natsSubscription *q : q_subs)
+    {
+        natsSubscription_Unsubscribe(q);
+    }
+    {
+        std::unique_lock<std::mutex> lock(q_mutex);
+        q_cv.wait(lock, [this]()
+                  { return q_done == q_subs.size(); });
+    }
+    for (natsSubscription *q : q_subs)
+    {
+        natsSubscription_Destroy(q);
+    }
+    q_subs.clear();
+    q_handlers.clear();
+    q_done = 0;
+}
+
+uint64_t nats_client::subscription_dropped() const
 {
-    if (natsConnection_Publish(con, subject, data, len) == NATS_ERR)
+    uint64_t total = 0;
+    for (natsSubscription *q : q_subs)
+    {
+        int64_t n = 0;
+        if (natsSubscription_GetDropped(q, &n) == NATS_OK)
+            total += n;
+    }
+    return total;
+}
+
+void nats_client::nats_send_data(const void *data, int len, const char *subject)
+{
+    if (natsConnection_Publish(con, subject, data, len) != NATS_OK)
     {
         throw std::runtime_error("nats send error");
     }
-}
\ No newline at end of file
+}
+
+// ---- mpsc_ring (bounded queue with per-slot sequence numbers)
+
+nats_client::mpsc_ring::mpsc_ring(size_t size, size_t max_record)
+    : mask(std::bit_ceil(size < 2 ? size_t(2) : size) - 1), rec_size(max_record),
+      slots(new slot[mask + 1]), data(new char[(mask + 1) * max_record])
+{
+    for (size_t i = 0; i <= mask; i++)
+    {
+        slots[i].seq.store(i, std::memory_order_relaxed);
+        slots[i].len = 0;
+    }
+}
+
+bool nats_client::mpsc_ring::push(const void *rec, size_t len)
+{
+    size_t pos = head.load(std::memory_order_relaxed);
+    slot *s;
+    while (1)
+    {
+        s = &slots[pos & mask];
+        size_t seq = s->seq.load(std::memory_order_acquire);
+        intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (dif == 0)
+        {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (dif < 0)
+            return false; // full
+        else
+            pos = head.load(std::memory_order_relaxed);
+    }
+
+    std::memcpy(data.get() + (pos & mask) * rec_size, rec, len);
+    s->len = len;
+    s->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <class F>
+bool nats_client::mpsc_ring::pop(F &&f)
+{
+    size_t pos = tail.load(std::memory_order_relaxed);
+    slot &s = slots[pos & mask];
+    if (s.seq.load(std::memory_order_acquire) != pos + 1)
+        return false;
+
+    f(data.get() + (pos & mask) * rec_size, static_cast<size_t>(s.len));
+
+    s.seq.store(pos + mask + 1, std::memory_order_release);
+    tail.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+// ---- async publishing
+
+void nats_client::start_async(const char *subject, const async_options &opt)
+{
+    if (sender.joinable())
+        throw std::logic_error("async publishing already started");
+    if (opt.max_record == 0 || opt.batch_bytes < opt.max_record + 10 || (opt.policy == async_options::FULL_SAMPLE && opt.sample_rate == 0))
+        throw std::invalid_argument("invalid async_options");
+
+    a_opt = opt;
+    a_subject = subject;
+    queue = std::make_unique<mpsc_ring>(opt.queue_size, opt.max_record);
+    a_stop = false;
+    sender = std::thread([this]()
+                         { sender_loop(); });
+}
+
+bool nats_client::publish_async(const void *data, size_t len)
+{
+    if (!queue)
+        throw std::logic_error("start_async was not called");
+
+    // seq_cst with the a_stop store : a call that sees the sender running is waited for by its last drain
+    a_producers.fetch_add(1);
+    struct in_progress
+    {
+        std::atomic<uint32_t> &n;
+        ~in_progress() { n.fetch_sub(1, std::memory_order_release); }
+    } guard{a_producers};
+
+    if (a_stop.load())
+    {
+        c_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (len > a_opt.max_record)
+    {
+        c_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (a_opt.policy == async_options::FULL_SAMPLE && queue->size() >= queue->capacity() / 4 * 3)
+    {
+        if (sample_counter.fetch_add(1, std::memory_order_relaxed) % a_opt.sample_rate != 0)
+        {
+            c_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // FULL_BLOCK : yield first (the sender frees a slot per pop), then sleep like the idle sender
+    for (int tries = 0; !queue->push(data, len); tries++)
+    {
+        if (a_opt.policy != async_options::FULL_BLOCK || a_stop.load(std::memory_order_relaxed))
+        {
+            c_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (tries < 16)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    c_queued.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void nats_client::publish_batch(std::string &batch, size_t records)
+{
+    if (records == 0)
+        return;
+
+    // sent (field 2, fixed64 little endian) -> the server measures publish to insert latency
+    uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    batch.push_back(static_cast<char>((2 << 3) | 1));
+    for (int i = 0; i < 8; i++)
+    {
+        batch.push_back(static_cast<char>(now >> (8 * i)));
+    }
+
+    if (natsConnection_Publish(con, a_subject.c_str(), batch.data(), batch.size()) == NATS_OK)
+    {
+        c_sent.fetch_add(records, std::memory_order_relaxed);
+        c_batches.fetch_add(1, std::memory_order_relaxed);
+        size_t bucket = std::bit_width(records) - 1;
+        if (bucket >= async_stats::hist_size)
+            bucket = async_stats::hist_size - 1;
+        c_hist[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        c_errors.fetch_add(1, std::memory_order_relaxed);
+        c_dropped.fetch_add(records, std::memory_order_relaxed);
+    }
+
+    batch.clear(); // keeps the capacity
+}
+
+void nats_client::sender_loop()
+{
+    using clock = std::chrono::steady_clock;
+
+    std::string batch;
+    batch.reserve(a_opt.batch_bytes + 9); // + sent
+    size_t records = 0;
+    clock::time_point first;
+    const auto max_age = std::chrono::milliseconds(a_opt.batch_ms);
+
+    // record -> field 1, wire type 2 (length-delimited)
+    auto append = [&](const char *rec, size_t len)
+    {
+        if (records == 0)
+            first = clock::now();
+
+        batch.push_back(static_cast<char>((1 << 3) | 2));
+        size_t v = len;
+        while (v >= 0x80)
+        {
+            batch.push_back(static_cast<char>(v | 0x80));
+            v >>= 7;
+        }
+        batch.push_back(static_cast<char>(v));
+        batch.append(rec, len);
+        records++;
+    };
+
+    while (1)
+    {
+        bool stop = a_stop.load(std::memory_order_acquire);
+        bool got = false;
+
+        while (batch.size() + a_opt.max_record + 10 <= a_opt.batch_bytes && queue->pop(append))
+            got = true;
+
+        if (batch.size() + a_opt.max_record + 10 > a_opt.batch_bytes || (records != 0 && clock::now() - first >= max_age))
+        {
+            publish_batch(batch, records);
+            records = 0;
+            continue;
+        }
+
+        // queued = sent + dropped : stop only when no publish_async can still push
+        if (stop && !got && a_producers.load() == 0 && queue->size() == 0)
+            break;
+
+        if (!got)
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    publish_batch(batch, records);
+    natsConnection_FlushTimeout(con, 1000);
+}
+
+void nats_client::stop_async()
+{
+    if (!sender.joinable())
+        return;
+    a_stop.store(true);
+    sender.join();
+}
+
+async_stats nats_client::get_async_stats() const
+{
+    async_stats st;
+    st.queued = c_queued.load(std::memory_order_relaxed);
+    st.sent = c_sent.load(std::memory_order_relaxed);
+    st.dropped = c_dropped.load(std::memory_order_relaxed);
+    st.batches = c_batches.load(std::memory_order_relaxed);
+    st.publish_errors = c_errors.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < async_stats::hist_size; i++)
+    {
+        st.batch_hist[i] = c_hist[i].load(std::memory_order_relaxed);
+    }
+    return st;
+}
@@ -1,6 +1,46 @@
 #pragma once
 
 #include <nats.h>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <array>
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// options for nats_client::start_async
+struct async_options
+{
+    // what publish_async does when the queue is full
+    enum full_policy
+    {
+        FULL_DROP,   // drop the new record
+        FULL_BLOCK,  // wait until the sender frees a slot
+        FULL_SAMPLE  // above 3/4 of the queue keep only 1 of sample_rate records, drop when full
+    };
+
+    size_t queue_size = 1 << 16; // records, rounded up to a power of 2
+    size_t max_record = 256;     // bytes, bigger records are dropped
+    size_t batch_bytes = 64 * 1024;
+    uint32_t batch_ms = 50;      // max age of the first record in a batch
+    full_policy policy = FULL_DROP;
+    uint32_t sample_rate = 8;    // > 0 for FULL_SAMPLE
+};
+
+struct async_stats
+{
+    static constexpr size_t hist_size = 16;
+
+    uint64_t queued = 0, sent = 0, dropped = 0, batches = 0, publish_errors = 0;
+    // batch_hist[i] -> batches with [2^i, 2^(i+1)) records
+    std::array<uint64_t, hist_size> batch_hist{};
+};
 
 class nats_client
 {
@@ -10,6 +50,68 @@ private:
     natsSubscription *sub = NULL;
     natsMsg *msg = NULL;
 
+    // bounded lock-free queue, many producers (capture threads) / one consumer (sender thread)
+    class mpsc_ring
+    {
+    private:
+        struct slot
+        {
+            std::atomic<size_t> seq;
+            uint32_t len;
+        };
+
+        size_t mask, rec_size;
+        std::unique_ptr<slot[]> slots;
+        std::unique_ptr<char[]> data;
+
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+
+    public:
+        mpsc_ring(size_t size, size_t max_record);
+
+        bool push(const void *rec, size_t len);
+        // calls f(const char *, size_t) for the oldest record, false if empty
+        template <class F>
+        bool pop(F &&f);
+
+        // tail first : a pop between the two loads can not make head - tail wrap,
+        // the clamp covers the loads being relaxed
+        size_t size() const
+        {
+            size_t t = tail.load(std::memory_order_relaxed);
+            size_t h = head.load(std::memory_order_relaxed);
+            if (h < t)
+                return 0;
+            return h - t > mask + 1 ? mask + 1 : h - t;
+        }
+        size_t capacity() const { return mask + 1; }
+    };
+
+    // queue group subscriptions, one delivery thread each (handlers never move, the list keeps their address)
+    std::vector<natsSubscription *> q_subs;
+    std::list<std::function<void(const char *, int)>> q_handlers;
+    // q_done : subscriptions whose delivery thread ended (no handler call after it)
+    std::mutex q_mutex;
+    std::condition_variable q_cv;
+    size_t q_done = 0;
+    static void on_queue_complete(void *closure);
+
+    std::unique_ptr<mpsc_ring> queue;
+    async_options a_opt;
+    std::string a_subject;
+    std::thread sender;
+    std::atomic<bool> a_stop{false};
+    std::atomic<uint32_t> a_producers{0}; // publish_async calls in progress, the sender drains after them
+    std::atomic<uint64_t> sample_counter{0};
+
+    // written by producers / the sender thread, read by get_async_stats
+    std::atomic<uint64_t> c_queued{0}, c_sent{0}, c_dropped{0}, c_batches{0}, c_errors{0};
+    std::array<std::atomic<uint64_t>, async_stats::hist_size> c_hist{};
+
+    void sender_loop();
+    void publish_batch(std::string &batch, size_t records);
+
 public:
     ~nats_client();
 
@@ -17,11 +119,46 @@ public:
     void nats_client_connect();
 
     // subscribe clien to some subscription
-    void nats_client_subscribe(const char const *subject);
+    void nats_client_subscribe(const char *subject);
+
+    /*
+        subscribe as a member of queue group queue : nats-server gives every message of subject
+        to only one member (other processes or other calls of this function)
+        every call is a new subscription with its own delivery thread, h is called from that thread only
+    */
+    void nats_client_queue_subscribe(const char *subject, const char *queue, std::function<void(const char *, int)> h);
+
+    // stop the queue subscriptions and wait until the messages already received are handled
+    void nats_client_drain(int64_t timeout_ms = 10000);
+
+    /*
+        unsubscribe the queue subscriptions (messages not handled yet are lost), wait until no handler
+        runs any more and destroy them : the handlers can be freed after it (call it when drain failed)
+    */
+    void nats_client_close_queues();
+
+    // messages dropped by the client library for the queue subscriptions (slow consumer)
+    uint64_t subscription_dropped() const;
 
     // send binary data to client
-    void nats_send_data(const void *data, int len, const char const *subject);
+    void nats_send_data(const void *data, int len, const char *subject);
+
+    /*
+        async mode : publish_async only copies the record into the queue,
+        a sender thread packs records into batches and publishes them to subject
+        batch layout is the protobuf wire format of `repeated bytes/message = 1` + `fixed64 sent = 2`
+        (pack_batch / flow_batch in pack_v2.proto), flushed by batch_bytes or batch_ms
+    */
+    void start_async(const char *subject, const async_options &opt = async_options());
+
+    // thread-safe, false if the record was dropped (also after stop_async)
+    bool publish_async(const void *data, size_t len);
+
+    // sends what is still queued and stops the sender thread
+    void stop_async();
+
+    async_stats get_async_stats() const;
 
     // Only for database [Handler function for natsConnection_Subscribe -> onMsg]
     inline static std::function<void(const char *, int)> Hfunc;
-};
\ No newline at end of file
+};
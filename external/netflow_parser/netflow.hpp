@@ -4,16 +4,28 @@
 #include <stdexcept>
 #include <cstdint>
 #include <cstring>
+#include <cstddef>
 #include <vector>
-#include <map>
 #include <netinet/in.h>
 #include <array>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <unordered_map>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NETFLOW_X86 1
+#endif
 
 struct common_netflow_header
 {
     uint16_t version, count;
 
-    constexpr void to_current_byte_order(){
+    void to_current_byte_order(){
             #if __BYTE_ORDER == __LITTLE_ENDIAN
             version = ntohs(version);
             count = ntohs(count);
@@ -40,7 +52,7 @@ namespace netflow_v5
 #endif
         } sampling_interval;
 
-        constexpr void to_current_byte_order(){
+        void to_current_byte_order(){
             #if __BYTE_ORDER == __LITTLE_ENDIAN
             common.to_current_byte_order();
             sys_uptime = ntohl(sys_uptime);
@@ -63,7 +75,7 @@ namespace netflow_v5
         uint8_t src_mask, dst_mask;
         uint16_t pad2;
 
-        constexpr void to_current_byte_order(){
+        void to_current_byte_order(){
             #if __BYTE_ORDER == __LITTLE_ENDIAN
             srcaddr = ntohl(srcaddr);
             dstaddr = ntohl(dstaddr);
@@ -91,7 +103,7 @@ namespace netflow_v5
      * if the calculated size of DataFlowRecord_array is higher then data packet length,
      * this function will throw an length_error
      */
-    std::vector<FlowRecord> parseFlow(Header &header, const unsigned char *data, const size_t pack_len)
+    inline std::vector<FlowRecord> parseFlow(Header &header, const unsigned char *data, const size_t pack_len)
     {
         if (pack_len < sizeof(FlowRecord) * ntohs(header.common.count))
             throw std::length_error("the size of the data packet does not match the calculated size");
@@ -103,6 +115,246 @@ namespace netflow_v5
 
         return flowset;
     }
+
+    static_assert(sizeof(FlowRecord) == 48, "FlowRecord must match the v5 wire layout");
+    static constexpr size_t MAX_RECORDS = 30; // v5 limit of records per packet
+
+    /*
+        byte swap of whole v5 records (wire -> host order), FlowRecord layout
+        every 16 bytes of a record have their own shuffle mask (3 per record)
+    */
+    namespace bswap
+    {
+        // shuffle masks for record bytes 0-15, 16-31, 32-47 (inline : one object for every translation unit)
+        alignas(32) inline constexpr uint8_t masks[3][16] = {
+            {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 13, 12, 15, 14},     // srcaddr dstaddr nexthop | input output
+            {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},     // dPkts dOctets first last
+            {1, 0, 3, 2, 4, 5, 6, 7, 9, 8, 11, 10, 12, 13, 15, 14}};    // ports | pad1 flags prot tos | src_as dst_as | masks | pad2
+
+        inline void scalar(FlowRecord *out, u_char const *in, size_t n)
+        {
+            memcpy(out, in, n * sizeof(FlowRecord));
+            for (size_t i = 0; i < n; i++){ out[i].to_current_byte_order(); }
+        }
+
+#ifdef NETFLOW_X86
+        __attribute__((target("ssse3"))) inline void ssse3(FlowRecord *out, u_char const *in, size_t n)
+        {
+            const __m128i m0 = _mm_load_si128((const __m128i *)masks[0]);
+            const __m128i m1 = _mm_load_si128((const __m128i *)masks[1]);
+            const __m128i m2 = _mm_load_si128((const __m128i *)masks[2]);
+            u_char *o = reinterpret_cast<u_char *>(out);
+            for (size_t i = 0; i < n; i++, in += 48, o += 48){
+                _mm_storeu_si128((__m128i *)o, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)in), m0));
+                _mm_storeu_si128((__m128i *)(o + 16), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 16)), m1));
+                _mm_storeu_si128((__m128i *)(o + 32), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 32)), m2));
+            }
+        }
+
+        // two records (96 bytes = 3 x 32) per step, vpshufb works per 128 bit lane
+        __attribute__((target("avx2"))) inline void avx2(FlowRecord *out, u_char const *in, size_t n)
+        {
+            const __m256i m01 = _mm256_loadu2_m128i((const __m128i *)masks[1], (const __m128i *)masks[0]);
+            const __m256i m20 = _mm256_loadu2_m128i((const __m128i *)masks[0], (const __m128i *)masks[2]);
+            const __m256i m12 = _mm256_loadu2_m128i((const __m128i *)masks[2], (const __m128i *)masks[1]);
+            u_char *o = reinterpret_cast<u_char *>(out);
+            size_t i = 0;
+            for (; i + 2 <= n; i += 2, in += 96, o += 96){
+                _mm256_storeu_si256((__m256i *)o, _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)in), m01));
+                _mm256_storeu_si256((__m256i *)(o + 32), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 32)), m20));
+                _mm256_storeu_si256((__m256i *)(o + 64), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 64)), m12));
+            }
+            if (i < n)
+                ssse3(reinterpret_cast<FlowRecord *>(o), in, n - i);
+        }
+#endif
+
+        using fn = void (*)(FlowRecord *, u_char const *, size_t);
+
+        // best implementation for this cpu, picked once
+        inline fn best()
+        {
+            static const fn f = []() -> fn {
+#if defined(NETFLOW_X86) && __BYTE_ORDER == __LITTLE_ENDIAN
+                if (__builtin_cpu_supports("avx2"))
+                    return avx2;
+                if (__builtin_cpu_supports("ssse3"))
+                    return ssse3;
+#endif
+                return scalar;
+            }();
+            return f;
+        }
+    };
+
+    /*
+        structure-of-arrays output of decode_bulk, host byte order
+        columns are allocated once (capacity rows), only [0, rows) is valid : the vectors are capacity long,
+        they can not be moved into a clickhouse column as they are
+        -> table_writer::append_columns(rows, c.srcaddr.data(), ...) copies the filled rows
+        (addresses are host order numbers : ColumnUInt32, ColumnIPv4::Append(uint32_t) expects network order)
+    */
+    struct flow_columns
+    {
+        size_t rows = 0, capacity = 0;
+        std::vector<uint32_t> srcaddr, dstaddr, nexthop, dPkts, dOctets, first, last;
+        std::vector<uint16_t> input, output, srcport, dstport, src_as, dst_as;
+        std::vector<uint8_t> tcp_flags, prot, tos, src_mask, dst_mask;
+        // from the packet header, per row
+        std::vector<uint32_t> unix_secs, sys_uptime;
+        std::vector<uint8_t> engine_type, engine_id;
+
+        explicit flow_columns(size_t cap = 4096) { resize(cap); }
+
+        // every column to cap rows, throws if the filled rows do not fit
+        void resize(size_t cap)
+        {
+            if (cap < rows)
+                throw std::length_error("flow_columns::resize below the filled rows");
+            capacity = cap;
+            for (auto *c : {&srcaddr, &dstaddr, &nexthop, &dPkts, &dOctets, &first, &last, &unix_secs, &sys_uptime}){ c->resize(cap); }
+            for (auto *c : {&input, &output, &srcport, &dstport, &src_as, &dst_as}){ c->resize(cap); }
+            for (auto *c : {&tcp_flags, &prot, &tos, &src_mask, &dst_mask, &engine_type, &engine_id}){ c->resize(cap); }
+        }
+
+        size_t free() const { return capacity - rows; }
+
+        void clear() { rows = 0; }
+    };
+
+    // flow_sequence gaps per (exporter, engine_type, engine_id)
+    class sequence_tracker
+    {
+    private:
+        struct state
+        {
+            uint32_t next;
+            uint64_t received = 0, lost = 0, reordered = 0;
+        };
+
+        std::unordered_map<uint64_t, state> engines;
+
+    public:
+        struct engine_stats
+        {
+            uint64_t received = 0, lost = 0, reordered = 0;
+        };
+
+        /**
+         * @param sequence -> flow_sequence of the header (flows sent before this packet)
+         * @return flows lost since the previous packet of this engine
+         */
+        uint64_t update(uint32_t exporter, uint8_t engine_type, uint8_t engine_id, uint32_t sequence, uint16_t count)
+        {
+            uint64_t key = (uint64_t(exporter) << 16) | (uint16_t(engine_type) << 8) | engine_id;
+            auto [it, added] = engines.try_emplace(key);
+            state &s = it->second;
+            uint64_t lost = 0;
+
+            if (!added){
+                // signed distance handles the 32 bit wrap
+                int32_t gap = static_cast<int32_t>(sequence - s.next);
+                if (gap > 0){
+                    lost = gap;
+                    s.lost += gap;
+                }
+                else if (gap < 0){
+                    s.reordered++;
+                    s.received += count;
+                    return 0; // late packet, keep the expected sequence
+                }
+            }
+
+            s.next = sequence + count;
+            s.received += count;
+            return lost;
+        }
+
+        engine_stats get(uint32_t exporter, uint8_t engine_type, uint8_t engine_id) const
+        {
+            auto it = engines.find((uint64_t(exporter) << 16) | (uint16_t(engine_type) << 8) | engine_id);
+            if (it == engines.end())
+                return {};
+            return {it->second.received, it->second.lost, it->second.reordered};
+        }
+
+        engine_stats total() const
+        {
+            engine_stats t;
+            for (const auto &[k, s] : engines){
+                t.received += s.received;
+                t.lost += s.lost;
+                t.reordered += s.reordered;
+            }
+            return t;
+        }
+    };
+
+    /**
+     * @param packet -> the whole v5 packet (from the netflow header)
+     * @param exporter -> exporter address for sequence tracking (any id)
+     *
+     * @brief
+     * header + records are converted to host byte order (SIMD when the cpu has it)
+     * and appended to out, throws length_error if the packet is shorter than count records
+     * or out has not enough free rows (MAX_RECORDS always fits when out.free() >= 30)
+     * @return number of appended rows
+     */
+    inline size_t decode_bulk(u_char const *packet, size_t pack_len, flow_columns &out, sequence_tracker *seq = nullptr, uint32_t exporter = 0)
+    {
+        if (pack_len < sizeof(Header))
+            throw std::length_error("the data packet is shorter than the v5 header");
+
+        Header h;
+        memcpy(&h, packet, sizeof(h));
+        h.to_current_byte_order();
+
+        if (h.common.version != 5)
+            throw std::runtime_error("Unexpected netflow version");
+        if (h.common.count > MAX_RECORDS || pack_len < sizeof(Header) + sizeof(FlowRecord) * h.common.count)
+            throw std::length_error("the size of the data packet does not match the calculated size");
+        if (out.free() < h.common.count)
+            throw std::length_error("flow_columns has not enough free rows");
+
+        FlowRecord recs[MAX_RECORDS];
+        bswap::best()(recs, packet + sizeof(Header), h.common.count);
+
+        // column by column : every loop writes one contiguous array
+        const size_t base = out.rows, n = h.common.count;
+        auto column = [&](auto &col, auto member){
+            auto *__restrict dst = col.data() + base;
+            for (size_t i = 0; i < n; i++){ dst[i] = recs[i].*member; }
+        };
+        column(out.srcaddr, &FlowRecord::srcaddr);
+        column(out.dstaddr, &FlowRecord::dstaddr);
+        column(out.nexthop, &FlowRecord::nexthop);
+        column(out.input, &FlowRecord::input);
+        column(out.output, &FlowRecord::output);
+        column(out.dPkts, &FlowRecord::dPkts);
+        column(out.dOctets, &FlowRecord::dOctets);
+        column(out.first, &FlowRecord::first);
+        column(out.last, &FlowRecord::last);
+        column(out.srcport, &FlowRecord::srcport);
+        column(out.dstport, &FlowRecord::dstport);
+        column(out.tcp_flags, &FlowRecord::tcp_flags);
+        column(out.prot, &FlowRecord::prot);
+        column(out.tos, &FlowRecord::tos);
+        column(out.src_as, &FlowRecord::src_as);
+        column(out.dst_as, &FlowRecord::dst_as);
+        column(out.src_mask, &FlowRecord::src_mask);
+        column(out.dst_mask, &FlowRecord::dst_mask);
+
+        std::fill_n(out.unix_secs.data() + base, n, h.unix_secs);
+        std::fill_n(out.sys_uptime.data() + base, n, h.sys_uptime);
+        std::fill_n(out.engine_type.data() + base, n, h.engine_type);
+        std::fill_n(out.engine_id.data() + base, n, h.engine_id);
+        out.rows += h.common.count;
+
+        if (seq != nullptr)
+            seq->update(exporter, h.engine_type, h.engine_id, h.flow_sequence, h.common.count);
+
+        return h.common.count;
+    }
 };
 
 namespace netflow_v9_v10
@@ -112,7 +364,7 @@ namespace netflow_v9_v10
         struct common_netflow_header common;
         uint32_t sysUptime, UnixSecs, SequenceNumber, SID;
 
-        constexpr void to_current_byte_order(){
+        void to_current_byte_order(){
             #if __BYTE_ORDER == __LITTLE_ENDIAN
             common.to_current_byte_order();
             sysUptime = ntohl(sysUptime);
@@ -123,274 +375,671 @@ namespace netflow_v9_v10
         }
     };
 
-    class NF9_10_Pack{
-    private:
-        header head;
+    // IPFIX (v10) message header, differs from the v9 one : length instead of count, no sysUptime
+    struct ipfix_header{
+        struct common_netflow_header common; // common.count is the message length for IPFIX
+        uint32_t ExportTime, SequenceNumber, ODID;
 
-        // frequently used structure used for : FlowSet_header, Field, DATA Template...
-        struct common_str{
-            uint16_t id, len;
-            
-            constexpr void to_current_byte_order(){
+        void to_current_byte_order(){
             #if __BYTE_ORDER == __LITTLE_ENDIAN
-            id = ntohs(id);
-            len = ntohs(len);
+            common.to_current_byte_order();
+            ExportTime = ntohl(ExportTime);
+            SequenceNumber = ntohl(SequenceNumber);
+            ODID = ntohl(ODID);
             #endif
+        }
+    };
+
+    // set ids (v9 flowset id / IPFIX set id)
+    static constexpr uint16_t V9_TEMPLATE = 0, V9_OPTIONS = 1, IPFIX_TEMPLATE = 2, IPFIX_OPTIONS = 3, FIRST_DATA_SET = 256;
+    // IPFIX variable-length field (RFC 7011 7.)
+    static constexpr uint16_t VARLEN = 0xffff;
+
+    struct field_desc{
+        uint16_t type, len;      // len == VARLEN -> length is read from the record
+        uint32_t enterprise;     // 0 -> IANA field
+        uint32_t offset;         // offset in the record, valid only if compiled_template::fixed
+        bool scope;              // options template scope field
+
+        bool operator==(const field_desc &) const = default;
+    };
+
+    /*
+        template compiled once when received : flat field table + fixed offsets,
+        data records are decoded from it without looking at the template flowset again
+    */
+    struct compiled_template{
+        uint16_t id = 0;
+        std::vector<field_desc> fields;
+        uint32_t min_size = 0; // size of a record (minimum size if !fixed)
+        bool fixed = true;     // no variable-length fields
+
+        bool operator==(const compiled_template &) const = default;
+
+        // column index of (type, enterprise) or -1
+        int find(uint16_t type, uint32_t enterprise = 0) const {
+            for (size_t i = 0; i < fields.size(); i++){
+                if (fields[i].type == type && fields[i].enterprise == enterprise)
+                    return i;
             }
+            return -1;
+        }
+    };
+
+    /*
+        decoded data records of one template, column per field
+        fields up to 8 bytes are stored as numbers (host byte order) in column::num,
+        longer and variable-length fields are copied into bytes and referenced by column::off/len
+        reset() keeps the capacity -> no allocations once the batch is warm
+    */
+    struct record_batch{
+        struct column{
+            std::vector<uint64_t> num;
+            std::vector<uint32_t> off, len;
         };
 
-        struct Option_header{
-            uint16_t id, s_len, len;
-            
-            constexpr void to_current_byte_order(){
-            #if __BYTE_ORDER == __LITTLE_ENDIAN
-            id = ntohs(id);
-            s_len = ntohs(s_len);
-            len = ntohs(len);
-            #endif
+        const compiled_template *tmpl = nullptr;
+        size_t rows = 0;
+        std::vector<column> cols;
+        std::vector<u_char> bytes;
+
+        void reset(const compiled_template &t){
+            tmpl = &t;
+            rows = 0;
+            if (cols.size() < t.fields.size())
+                cols.resize(t.fields.size());
+            for (auto &c : cols){
+                c.num.clear();
+                c.off.clear();
+                c.len.clear();
             }
-        };
+            bytes.clear();
+        }
 
-        class Template{
-        private:
+        uint64_t u64(size_t col, size_t row) const { return cols[col].num[row]; }
 
-            std::vector<common_str> fields;
-            uint16_t id, count; 
-            size_t s = 0;
+        // raw value of a field longer than 8 bytes or variable-length
+        std::pair<const u_char*, size_t> raw(size_t col, size_t row) const {
+            return {bytes.data() + cols[col].off[row], cols[col].len[row]};
+        }
+    };
 
-        public:
-            Template() = default;
-            Template(u_char const * const flowset_buff, std::map<uint16_t, Template>& tmpl){ from_buffer(flowset_buff, tmpl); }
+    struct decode_stats{
+        uint64_t packets = 0, templates = 0, records = 0, no_template = 0, replayed = 0;
+    };
 
-            void from_buffer(u_char const * const flowset_buff, std::map<uint16_t, Template>& tmpl){
-                common_str flowset_header = *(common_str*)(flowset_buff);
-                flowset_header.to_current_byte_order();
+    // exporter address (IPv4 as ::ffff:a.b.c.d) + observation domain (v9 source ID / IPFIX ODID) + template id
+    struct template_key{
+        std::array<uint8_t, 16> exporter;
+        uint32_t domain;
+        uint16_t id;
+        uint8_t version;
+
+        bool operator==(const template_key &) const = default;
+
+        static std::array<uint8_t, 16> from_ipv4(uint32_t addr_host_order){
+            std::array<uint8_t, 16> a{};
+            a[10] = a[11] = 0xff;
+            a[12] = addr_host_order >> 24;
+            a[13] = addr_host_order >> 16;
+            a[14] = addr_host_order >> 8;
+            a[15] = addr_host_order;
+            return a;
+        }
+    };
 
-                size_t buffer_index = sizeof(common_str);
+    struct template_key_hash{
+        size_t operator()(const template_key &k) const {
+            // FNV-1a
+            uint64_t h = 1469598103934665603ull;
+            auto mix = [&h](u_char const *p, size_t n){
+                for (size_t i = 0; i < n; i++){ h = (h ^ p[i]) * 1099511628211ull; }
+            };
+            mix(k.exporter.data(), k.exporter.size());
+            mix(reinterpret_cast<u_char const*>(&k.domain), sizeof(k.domain));
+            mix(reinterpret_cast<u_char const*>(&k.id), sizeof(k.id));
+            mix(&k.version, 1);
+            return h;
+        }
+    };
 
-                // check if is data or option template
-                common_str template_data;
-                switch(flowset_header.id){
-                    case 0:{
-                        template_data = *(common_str*)(flowset_buff + buffer_index);
-                        buffer_index += sizeof(common_str);
-                        }
-                        break;
+    struct store_options{
+        std::chrono::seconds template_timeout{1800}; // template not refreshed for this time -> removed
+        size_t max_pending = 4096;                   // data sets waiting for a template
+        size_t max_pending_bytes = 8 * 1024 * 1024;
+        std::chrono::seconds pending_timeout{60};
+    };
 
-                    case 1:
-                        {
-                            Option_header oph = *(Option_header*)(flowset_buff + buffer_index);
-                            buffer_index += sizeof(Option_header);
+    struct store_stats{
+        uint64_t templates = 0, updates = 0, expired = 0, pending = 0, pending_dropped = 0, replayed = 0;
+    };
 
-                            template_data.id = oph.id;
-                            template_data.len = (oph.len + oph.s_len)/sizeof(common_str);
-                        }
-                        break;
+    /*
+        templates of all exporters, shared by the decoding threads
+        readers keep their own snapshot and reload it only when version() changed
+        (one atomic load per packet of a counter written only on updates, no lock, no shared refcount),
+        writers (new/changed template, expiry) copy the table, publish the copy and bump the version
+        a refresh of an unchanged template only updates its timestamp (no copy)
+        data sets without a template wait in a bounded queue and are replayed by the decoder
+    */
+    class template_store{
+    private:
+        struct entry{
+            compiled_template t;
+            mutable std::atomic<int64_t> seen_ms;
 
-                    default:
-                        throw std::logic_error("Error while check template type\n(0/1) for (DATA/OPTION) Template\nCurrent : ");
-                        break;
-                }
-                
-                template_data.to_current_byte_order();
+            entry(compiled_template &&tm, int64_t now) : t(std::move(tm)), seen_ms(now) {}
+        };
 
-                for(size_t i = 0; i < template_data.len; i++){
+    public:
+        using table = std::unordered_map<template_key, std::shared_ptr<const entry>, template_key_hash>;
+        using snapshot = std::shared_ptr<const table>;
 
-                    if (flowset_header.len < buffer_index + (template_data.len * sizeof(common_str))){
-                        throw std::runtime_error("FlowSet buffer length is insufficient for the next template.");
-                    }
+        struct pending_set{
+            template_key key;
+            int64_t at_ms;
+            std::vector<u_char> data;
+        };
 
-                    fields.push_back(*(common_str*)(flowset_buff + buffer_index));
-                    fields[fields.size() - 1].to_current_byte_order();
-                    s += fields[fields.size() - 1].len;
-                    buffer_index += sizeof(common_str);
-                }
+    private:
+        const store_options opt;
+        std::atomic<snapshot> current{std::make_shared<const table>()};
+        alignas(64) std::atomic<uint64_t> ver{0};
+        std::mutex write_mutex;
+
+        std::deque<pending_set> pending;
+        std::unordered_map<template_key, size_t, template_key_hash> pending_count; // sets per key in pending
+        size_t pending_bytes = 0;
+        std::mutex pending_mutex;
+
+        std::atomic<int64_t> next_expire{0};
+        std::atomic<uint64_t> c_updates{0}, c_expired{0}, c_pending{0}, c_dropped{0}, c_replayed{0};
+
+        // caller holds write_mutex
+        template <class F>
+        void modify(F &&f){
+            auto copy = std::make_shared<table>(*current.load(std::memory_order_acquire));
+            f(*copy);
+            current.store(std::move(copy), std::memory_order_release);
+            ver.fetch_add(1, std::memory_order_release); // after the store : a reader seeing it gets the new table
+        }
 
-                tmpl[template_data.id] = *this;
+        // caller holds pending_mutex
+        void uncount(const template_key &key, size_t n){
+            auto it = pending_count.find(key);
+            if ((it->second -= n) == 0)
+                pending_count.erase(it);
+        }
 
-                if (flowset_header.len == buffer_index + template_data.len){
-                    return;
-                }
+        // caller holds pending_mutex
+        void drop_oldest(){
+            pending_bytes -= pending.front().data.size();
+            uncount(pending.front().key, 1);
+            pending.pop_front();
+            c_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
 
-                // if we have more templates / create new flowset
+    public:
+        static int64_t now_ms(){
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        explicit template_store(const store_options &options = store_options()) : opt(options) {}
 
-                buffer_index -= sizeof(common_str);
+        snapshot get() const { return current.load(std::memory_order_acquire); }
 
-                size_t s = (flowset_header.len - buffer_index);
-                u_char *new_buff = new u_char[s];
+        // changes on every published table, read it before get()
+        uint64_t version() const { return ver.load(std::memory_order_acquire); }
 
-                flowset_header.to_current_byte_order();
+        // template from a snapshot, nullptr if unknown or timed out
+        const compiled_template *find(const snapshot &snap, const template_key &key, int64_t now) const {
+            auto it = snap->find(key);
+            if (it == snap->end())
+                return nullptr;
+            if (now - it->second->seen_ms.load(std::memory_order_relaxed) > std::chrono::milliseconds(opt.template_timeout).count())
+                return nullptr;
+            return &it->second->t;
+        }
 
-                memcpy(new_buff, &flowset_header, sizeof(common_str));
-                memcpy(new_buff + sizeof(common_str), flowset_buff + sizeof(common_str) + buffer_index, s);
+        // add / refresh a template, the returned pointer keeps it alive
+        std::shared_ptr<const compiled_template> put(const template_key &key, compiled_template &&t){
+            int64_t now = now_ms();
 
-                Template(new_buff, tmpl);
+            snapshot snap = get();
+            auto it = snap->find(key);
+            if (it != snap->end() && it->second->t == t){
+                it->second->seen_ms.store(now, std::memory_order_relaxed);
+                return std::shared_ptr<const compiled_template>(it->second, &it->second->t);
             }
 
-            const std::vector<common_str>& get_template_fields() const { return fields; }
+            auto e = std::make_shared<const entry>(std::move(t), now);
+            {
+                std::lock_guard<std::mutex> lock(write_mutex);
+                modify([&](table &tb){ tb[key] = e; });
+            }
+            c_updates.fetch_add(1, std::memory_order_relaxed);
+            return std::shared_ptr<const compiled_template>(e, &e->t);
+        }
 
-            size_t data_size() const { return s; }
+        void erase(const template_key &key){
+            std::lock_guard<std::mutex> lock(write_mutex);
+            modify([&](table &tb){ tb.erase(key); });
+        }
 
-            ~Template() = default;
+        // all templates of one exporter/domain/version (IPFIX withdraw-all)
+        void erase_all(const template_key &key){
+            std::lock_guard<std::mutex> lock(write_mutex);
+            modify([&](table &tb){
+                std::erase_if(tb, [&](const auto &kv){
+                    return kv.first.exporter == key.exporter && kv.first.domain == key.domain && kv.first.version == key.version;
+                });
+            });
+        }
 
-        };
+        /*
+            keep a copy of a data set until its template arrives, the oldest sets are dropped when full
+            the caller missed key in its snapshot : if the current table has it (published by another
+            decoder since), nothing is queued and the template is returned to decode the set now
+            (put publishes before take_pending locks pending_mutex : no set can be queued after it)
+        */
+        std::shared_ptr<const compiled_template> defer(const template_key &key, u_char const *data, size_t len){
+            std::lock_guard<std::mutex> lock(pending_mutex);
+
+            snapshot snap = get();
+            if (find(snap, key, now_ms()) != nullptr){
+                const auto &e = snap->at(key);
+                return std::shared_ptr<const compiled_template>(e, &e->t);
+            }
 
-        class Data{
-        private:
-            struct Flow{
-                uint16_t type, size;
-                u_char* buff;
-
-                constexpr void to_current_byte_order(){
-                #if __BYTE_ORDER == __LITTLE_ENDIAN
-                    type = ntohs(type);
-                    size = ntohs(size);
-                #endif
-                }
-            };
+            if (len > opt.max_pending_bytes || opt.max_pending == 0){
+                c_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
 
-            std::vector<std::vector<Flow>> flows;
+            while (!pending.empty() && (pending.size() >= opt.max_pending || pending_bytes + len > opt.max_pending_bytes))
+                drop_oldest();
 
-            Template t;
+            pending.push_back({key, now_ms(), std::vector<u_char>(data, data + len)});
+            pending_count[key]++;
+            pending_bytes += len;
+            c_pending.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
 
-        public:
-            Data() = default;
-            Data(u_char const * const flowset_buff, Template& tmpl){ from_buffer(flowset_buff, tmpl); }
+        // remove and return the data sets waiting for key (in arrival order)
+        std::vector<pending_set> take_pending(const template_key &key){
+            std::vector<pending_set> out;
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            // a template refresh usually has nothing waiting -> no scan
+            auto it = pending_count.find(key);
+            if (it == pending_count.end())
+                return out;
+            pending_count.erase(it);
+
+            std::deque<pending_set> keep;
+            for (auto &p : pending){
+                if (p.key == key){
+                    pending_bytes -= p.data.size();
+                    out.push_back(std::move(p));
+                }
+                else
+                    keep.push_back(std::move(p));
+            }
+            pending.swap(keep);
+            c_replayed.fetch_add(out.size(), std::memory_order_relaxed);
+            return out;
+        }
 
-            void from_buffer(u_char const * const flowset_buff, Template& tmpl){
-                common_str flow_hdr = *(common_str*)(flowset_buff);
-                flow_hdr.to_current_byte_order();
+        // drop timed out templates and pending sets, runs at most once per second (any thread may call it)
+        void expire(int64_t now){
+            int64_t next = next_expire.load(std::memory_order_relaxed);
+            if (now < next || !next_expire.compare_exchange_strong(next, now + 1000))
+                return;
+
+            const int64_t t_timeout = std::chrono::milliseconds(opt.template_timeout).count();
+            snapshot snap = get();
+            bool any = false;
+            for (const auto &kv : *snap){
+                if (now - kv.second->seen_ms.load(std::memory_order_relaxed) > t_timeout){
+                    any = true;
+                    break;
+                }
+            }
 
-                size_t buff_index = sizeof(common_str);
+            if (any){
+                std::lock_guard<std::mutex> lock(write_mutex);
+                modify([&](table &tb){
+                    c_expired.fetch_add(std::erase_if(tb, [&](const auto &kv){
+                        return now - kv.second->seen_ms.load(std::memory_order_relaxed) > t_timeout;
+                    }), std::memory_order_relaxed);
+                });
+            }
 
-                const std::vector<common_str> cur_field = tmpl.get_template_fields();
+            const int64_t p_timeout = std::chrono::milliseconds(opt.pending_timeout).count();
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            while (!pending.empty() && now - pending.front().at_ms > p_timeout)
+                drop_oldest();
+        }
 
-                while(1){
-                    if((tmpl.data_size() + buff_index) > (flow_hdr.len - sizeof(uint32_t))){
-                        throw std::runtime_error("error while reading data-flowset, insufficent flowset size");
-                    }
+        store_stats stats() const {
+            store_stats st;
+            st.templates = get()->size();
+            st.updates = c_updates.load(std::memory_order_relaxed);
+            st.expired = c_expired.load(std::memory_order_relaxed);
+            st.pending = c_pending.load(std::memory_order_relaxed);
+            st.pending_dropped = c_dropped.load(std::memory_order_relaxed);
+            st.replayed = c_replayed.load(std::memory_order_relaxed);
+            return st;
+        }
+    };
 
-                    std::vector<Flow> cur_flow;
+    // big endian value of 1..8 bytes
+    inline uint64_t load_be(u_char const *p, size_t n){
+        switch (n){
+            case 1: return p[0];
+            case 2: return (uint16_t(p[0]) << 8) | p[1];
+            case 4: { uint32_t v; memcpy(&v, p, 4); return ntohl(v); }
+            case 8: { uint32_t h, l; memcpy(&h, p, 4); memcpy(&l, p + 4, 4); return (uint64_t(ntohl(h)) << 32) | ntohl(l); }
+            default:
+            {
+                uint64_t v = 0;
+                for (size_t i = 0; i < n; i++){ v = (v << 8) | p[i]; }
+                return v;
+            }
+        }
+    }
 
-                    for(size_t i = 0; i < cur_field.size(); i++){
-                        Flow f;
-                        f.type = cur_field[i].id;
-                        f.size = cur_field[i].len;
+    /*
+        NetFlow v9 / IPFIX decoder, one per decoding thread, all of them can share one template_store
+        templates are compiled when received, every data flowset is decoded into a record_batch
+        and passed to the sink : sink(const template_key&, const record_batch&)
+        data flowsets received before their template are deferred and decoded when it arrives
+        the batch is reused for the next flowset, copy what you need inside the sink
+        malformed packets throw std::runtime_error (flowsets before the error are already delivered)
+    */
+    class decoder{
+    private:
+        std::shared_ptr<template_store> store;
+        decode_stats st;
+
+        // own copy of the store table, reloaded only when the store version changes
+        template_store::snapshot snap;
+        uint64_t snap_version = UINT64_MAX;
+
+        const template_store::snapshot &current(){
+            uint64_t v = store->version();
+            if (v != snap_version){
+                snap = store->get();
+                snap_version = v;
+            }
+            return snap;
+        }
 
-                        f.buff = new u_char[f.size];
-                        memcpy(f.buff, (flowset_buff + buff_index), f.size);
+        // check the bounds of one set, v9 length includes padding, IPFIX length is exact
+        static void need(size_t index, size_t n, size_t end){
+            if (index + n > end)
+                throw std::runtime_error("netflow: set length is insufficient for the next field");
+        }
 
-                        buff_index += f.size;
-                        cur_flow.push_back(f);
-                    }
+        // template / options template set -> compiled templates, deferred data sets of them are replayed
+        template <class Sink>
+        void read_templates(template_key key, uint16_t set_id, u_char const *p, size_t len, record_batch &batch, Sink &sink){
+            size_t i = 0;
 
-                    flows.push_back(cur_flow);
-                }
+            // v9 sets are padded to 4 bytes, a template header is at least 4 bytes
+            while (len - i >= 4){
+                compiled_template t;
+                uint16_t field_count, scope_count = 0;
 
-                t = tmpl;
-            }
-        };
+                t.id = load_be(p + i, 2);
 
-        // map<version, map<templateID, Template>>
-        static std::map<uint8_t, std::map<uint16_t, Template>> tmpls; // all templates
+                switch (set_id){
+                    case V9_TEMPLATE:
+                    case IPFIX_TEMPLATE:
+                        field_count = load_be(p + i + 2, 2);
+                        i += 4;
+                        break;
 
-        // std::vector<std::pair<flowset id, Data flow>>
-        std::vector<std::pair<uint16_t, Data>> dataflows; // all readed flows by template id
-        std::vector<u_char*> no_tmpl; // data without a template
+                    case V9_OPTIONS:
+                    {
+                        need(i, 6, len);
+                        // scope/option lengths are in bytes (4 bytes per field)
+                        uint16_t scope_len = load_be(p + i + 2, 2), opt_len = load_be(p + i + 4, 2);
+                        scope_count = scope_len / 4;
+                        field_count = (scope_len + opt_len) / 4;
+                        i += 6;
+                    }
+                        break;
 
-    public:
-        NF9_10_Pack() = default;
+                    case IPFIX_OPTIONS:
+                        field_count = load_be(p + i + 2, 2);
+                        i += 4;
+                        if (field_count != 0){
+                            need(i, 2, len);
+                            scope_count = load_be(p + i, 2);
+                            i += 2;
+                        }
+                        break;
 
-        NF9_10_Pack(u_char const * const buffer, size_t length) { from_buffer(buffer, length); }
+                    default:
+                        throw std::logic_error("netflow: not a template set");
+                }
 
-        void from_buffer(u_char const * const buffer, size_t length){
-            head = *(header*)buffer;
+                if (t.id == 0 && field_count == 0)
+                    break; // padding
 
-            head.to_current_byte_order();
+                key.id = t.id;
 
-            // additional check netflow version
-            switch (head.common.version)
-            {
-            case 9:
-            case 10:
-                // good netflow version
-                break;
+                // IPFIX template withdrawal (id == set id -> all templates of the set)
+                if (field_count == 0){
+                    if (t.id == set_id)
+                        store->erase_all(key);
+                    else
+                        store->erase(key);
+                    continue;
+                }
 
-            default:
-                throw std::runtime_error("Unexpected netflow version");
-                break;
-            }
+                if (t.id < FIRST_DATA_SET)
+                    throw std::runtime_error("netflow: template id < 256");
+
+                t.fields.reserve(field_count);
+                for (uint16_t f = 0; f < field_count; f++){
+                    need(i, 4, len);
+                    field_desc d;
+                    d.type = load_be(p + i, 2);
+                    d.len = load_be(p + i + 2, 2);
+                    d.enterprise = 0;
+                    d.scope = f < scope_count;
+                    i += 4;
+
+                    // IPFIX enterprise bit -> 4 bytes enterprise number
+                    if (key.version == 10 && (d.type & 0x8000)){
+                        need(i, 4, len);
+                        d.type &= 0x7fff;
+                        d.enterprise = load_be(p + i, 4);
+                        i += 4;
+                    }
 
-            size_t flow_buf_index = sizeof(header);
+                    if (d.len == VARLEN){
+                        if (key.version != 10)
+                            throw std::runtime_error("netflow: variable-length field in v9 template");
+                        t.fixed = false;
+                        d.offset = t.min_size;
+                        t.min_size += 1;
+                    }
+                    else{
+                        d.offset = t.min_size;
+                        t.min_size += d.len;
+                    }
+                    t.fields.push_back(d);
+                }
 
-            // loop for differnt flowsets
-            for(size_t i = 0; flow_buf_index < length; i++){
-                common_str flow_hdr = *(common_str*)(buffer + flow_buf_index);
+                if (t.min_size == 0)
+                    throw std::runtime_error("netflow: template with zero record size");
 
-                flow_hdr.to_current_byte_order();
+                auto compiled = store->put(key, std::move(t));
+                st.templates++;
 
-                if ((sizeof(header) + flow_buf_index + flow_hdr.len) > length){
-                    throw std::runtime_error("Buffer length is insufficient for the next flowset.");
+                for (auto &ps : store->take_pending(key)){
+                    read_data(*compiled, ps.data.data(), ps.data.size(), batch);
+                    st.replayed += batch.rows;
+                    if (batch.rows != 0)
+                        sink(static_cast<const template_key&>(key), static_cast<const record_batch&>(batch));
                 }
+            }
+        }
 
-                flow_buf_index += sizeof(common_str);
-                uint16_t current_base_index = flow_buf_index;
+        // data set -> batch, records are read until the remaining bytes cannot hold one (padding)
+        void read_data(const compiled_template &t, u_char const *p, size_t len, record_batch &batch){
+            batch.reset(t);
+            size_t i = 0;
 
-                // loops for different Template, Option or Data in the same flowset
-                u_char *temp_buff = nullptr; 
+            auto put_bytes = [&](size_t col, u_char const *v, size_t n){
+                auto &c = batch.cols[col];
+                c.off.push_back(batch.bytes.size());
+                c.len.push_back(n);
+                batch.bytes.insert(batch.bytes.end(), v, v + n);
+            };
 
-                // --- Templates / Options
-                if (flow_hdr.id == 0 || flow_hdr.id == 1){
-                    Template((buffer + flow_buf_index), tmpls[head.common.version]);
-                    tmpls[head.common.version];
-                    for(;flow_buf_index < (current_base_index + flow_hdr.len);){
+            if (t.fixed){
+                for (; i + t.min_size <= len; i += t.min_size){
+                    u_char const *rec = p + i;
+                    for (size_t f = 0; f < t.fields.size(); f++){
+                        const field_desc &d = t.fields[f];
+                        if (d.len <= 8)
+                            batch.cols[f].num.push_back(load_be(rec + d.offset, d.len));
+                        else
+                            put_bytes(f, rec + d.offset, d.len);
+                    }
+                    batch.rows++;
+                }
+            }
+            else{
+                while (i + t.min_size <= len){
+                    size_t r = i;
+                    for (size_t f = 0; f < t.fields.size(); f++){
+                        const field_desc &d = t.fields[f];
+                        size_t n = d.len;
+                        if (d.len == VARLEN){
+                            need(r, 1, len);
+                            n = p[r++];
+                            if (n == 255){
+                                need(r, 2, len);
+                                n = load_be(p + r, 2);
+                                r += 2;
+                            }
+                            need(r, n, len);
+                            put_bytes(f, p + r, n);
+                        }
+                        else{
+                            need(r, n, len);
+                            if (n <= 8)
+                                batch.cols[f].num.push_back(load_be(p + r, n));
+                            else
+                                put_bytes(f, p + r, n);
+                        }
+                        r += n;
+                    }
+                    i = r;
+                    batch.rows++;
+                }
+            }
+
+            st.records += batch.rows;
+        }
 
-                        //get template id and template count
-                        common_str template_head = *(common_str*)(buffer + flow_buf_index);
-                        template_head.to_current_byte_order();
+    public:
+        explicit decoder(std::shared_ptr<template_store> templates = std::make_shared<template_store>()) : store(std::move(templates)) {}
+
+        /**
+         * @param exporter -> address the packet came from (template_key::from_ipv4 for IPv4)
+         * @param buffer -> netflow v9 / IPFIX packet (from the netflow header)
+         * @param batch -> reused for every data flowset
+         * @return number of decoded data records (replayed ones included)
+         */
+        template <class Sink>
+        size_t decode(const std::array<uint8_t, 16> &exporter, u_char const * const buffer, size_t length, record_batch &batch, Sink &&sink){
+            if (length < sizeof(common_netflow_header))
+                throw std::runtime_error("netflow: packet shorter than header");
+
+            template_key key;
+            key.exporter = exporter;
+            key.id = 0;
+
+            // whole 16 bit version : template_key::version is narrowed only once it is 9 or 10
+            const uint16_t version = load_be(buffer, 2);
+            size_t index;
+            switch (version){
+                case 9:
+                    index = sizeof(header);
+                    if (length < index)
+                        throw std::runtime_error("netflow: packet shorter than header");
+                    key.domain = load_be(buffer + offsetof(header, SID), 4);
+                    break;
+                case 10:
+                    index = sizeof(ipfix_header);
+                    if (length < index)
+                        throw std::runtime_error("netflow: packet shorter than header");
+                    key.domain = load_be(buffer + offsetof(ipfix_header, ODID), 4);
+                    // IPFIX message length, the rest of the datagram is ignored
+                    if (size_t msg_len = load_be(buffer + 2, 2); msg_len < index)
+                        throw std::runtime_error("netflow: IPFIX message length shorter than header");
+                    else if (msg_len < length)
+                        length = msg_len;
+                    break;
+                default:
+                    throw std::runtime_error("Unexpected netflow version");
+            }
+            key.version = static_cast<uint8_t>(version);
 
-                        // create a buffer for Template constructor
+            st.packets++;
+            const uint64_t records_before = st.records;
+            const int64_t now = template_store::now_ms();
+            store->expire(now);
+            const template_store::snapshot *tables = &current();
 
-                        if (template_head.len > flow_hdr.len){
-                            throw std::runtime_error("FlowSet buffer length is insufficient for the next template.");
-                        }
+            // loop for differnt flowsets
+            while (length - index >= 4){
+                uint16_t set_id = load_be(buffer + index, 2), set_len = load_be(buffer + index + 2, 2);
 
-                        temp_buff = new u_char[template_head.len];
-                        memcpy(temp_buff, (buffer + flow_buf_index), template_head.len);
+                if (set_len < 4 || index + set_len > length)
+                    throw std::runtime_error("Buffer length is insufficient for the next flowset.");
 
-                        tmpls[head.common.version][template_head.id] = Template(temp_buff, tmpls[head.common.version]);
+                u_char const *body = buffer + index + 4;
+                size_t body_len = set_len - 4;
 
-                        flow_buf_index += template_head.len;
-                    }
+                if (set_id == V9_TEMPLATE || set_id == V9_OPTIONS || set_id == IPFIX_TEMPLATE || set_id == IPFIX_OPTIONS){
+                    if ((key.version == 9) != (set_id < IPFIX_TEMPLATE))
+                        throw std::runtime_error("netflow: template set id does not match the version");
+                    read_templates(key, set_id, body, body_len, batch, sink);
+                    tables = &current(); // see the templates just received
                 }
-                // --- Data Flow
-                else{
-                    uint32_t padding = *(uint32_t*)(buffer + (flow_buf_index + flow_hdr.len - sizeof(uint32_t)));
-                    if (padding != 0){
-                        throw std::runtime_error("data-flowset does not match the patern (padding != 0)");
-                    }
+                else if (set_id >= FIRST_DATA_SET){
+                    key.id = set_id;
+                    const compiled_template *t = store->find(*tables, key, now);
 
-                    if (tmpls.contains(head.common.version) && tmpls[head.common.version].contains(flow_hdr.id)){
-                        dataflows.push_back(std::make_pair(flow_hdr.id, Data((buffer + flow_buf_index), tmpls[head.common.version][flow_hdr.id])));
-                    }
+                    std::shared_ptr<const compiled_template> late;
+                    if (t == nullptr && (late = store->defer(key, body, body_len)) != nullptr)
+                        t = late.get(); // published by another decoder after our snapshot
+
+                    if (t == nullptr)
+                        st.no_template++;
                     else{
-                        unreaded.push_back(new u_char[flow_hdr.len]);
-                        memcpy(unreaded[unreaded.size() - 1], buffer + flow_buf_index, flow_hdr.len);
+                        read_data(*t, body, body_len, batch);
+                        if (batch.rows != 0)
+                            sink(static_cast<const template_key&>(key), static_cast<const record_batch&>(batch));
                     }
                 }
+                // set ids 4..255 are reserved -> skipped
 
-                flow_buf_index += flow_hdr.len;
+                index += set_len;
             }
-        }
 
-        ~NF9_10_Pack(){
-            for (size_t i = 0; i < unreaded.size(); i++){
-                delete unreaded[i];
-                unreaded[i] = nullptr;   
-            }
+            return st.records - records_before;
         }
-        
-    private:
-        std::vector<u_char*> unreaded;
+
+        const template_store &templates() const { return *store; }
+
+        const decode_stats &stats() const { return st; }
     };
-};
\ No newline at end of file
+};
@@ -0,0 +1,1655 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: pack_v2.proto
+
+#include "pack_v2.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
+
+PROTOBUF_CONSTEXPR pack_v2::pack_v2(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.macs_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.s_ip6_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.d_ip6_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.time_)*/uint64_t{0u}
+  , /*decltype(_impl_.framesize_)*/0u
+  , /*decltype(_impl_.ipv_)*/0u
+  , /*decltype(_impl_.s_ip4_)*/0u
+  , /*decltype(_impl_.d_ip4_)*/0u
+  , /*decltype(_impl_.t_proto_)*/0
+  , /*decltype(_impl_.ports_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct pack_v2DefaultTypeInternal {
+  PROTOBUF_CONSTEXPR pack_v2DefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~pack_v2DefaultTypeInternal() {}
+  union {
+    pack_v2 _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 pack_v2DefaultTypeInternal _pack_v2_default_instance_;
+PROTOBUF_CONSTEXPR pack_batch::pack_batch(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.packs_)*/{}
+  , /*decltype(_impl_.sent_)*/uint64_t{0u}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct pack_batchDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR pack_batchDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~pack_batchDefaultTypeInternal() {}
+  union {
+    pack_batch _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 pack_batchDefaultTypeInternal _pack_batch_default_instance_;
+PROTOBUF_CONSTEXPR flow_v2::flow_v2(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.s_ip6_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.d_ip6_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.first_)*/uint64_t{0u}
+  , /*decltype(_impl_.last_)*/uint64_t{0u}
+  , /*decltype(_impl_.packets_)*/uint64_t{0u}
+  , /*decltype(_impl_.bytes_)*/uint64_t{0u}
+  , /*decltype(_impl_.ipv_)*/0u
+  , /*decltype(_impl_.s_ip4_)*/0u
+  , /*decltype(_impl_.d_ip4_)*/0u
+  , /*decltype(_impl_.t_proto_)*/0
+  , /*decltype(_impl_.ports_)*/0u
+  , /*decltype(_impl_.tcp_flags_)*/0u
+  , /*decltype(_impl_.end_reason_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct flow_v2DefaultTypeInternal {
+  PROTOBUF_CONSTEXPR flow_v2DefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~flow_v2DefaultTypeInternal() {}
+  union {
+    flow_v2 _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 flow_v2DefaultTypeInternal _flow_v2_default_instance_;
+PROTOBUF_CONSTEXPR flow_batch::flow_batch(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.flows_)*/{}
+  , /*decltype(_impl_.sent_)*/uint64_t{0u}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct flow_batchDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR flow_batchDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~flow_batchDefaultTypeInternal() {}
+  union {
+    flow_batch _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 flow_batchDefaultTypeInternal _flow_batch_default_instance_;
+static ::_pb::Metadata file_level_metadata_pack_5fv2_2eproto[4];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_pack_5fv2_2eproto[1];
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_pack_5fv2_2eproto = nullptr;
+
+const uint32_t TableStruct_pack_5fv2_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.time_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.framesize_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.macs_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.ipv_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.s_ip4_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.d_ip4_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.s_ip6_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.d_ip6_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.t_proto_),
+  PROTOBUF_FIELD_OFFSET(::pack_v2, _impl_.ports_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::pack_batch, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::pack_batch, _impl_.packs_),
+  PROTOBUF_FIELD_OFFSET(::pack_batch, _impl_.sent_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.first_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.last_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.packets_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.bytes_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.ipv_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.s_ip4_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.d_ip4_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.s_ip6_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.d_ip6_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.t_proto_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.ports_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.tcp_flags_),
+  PROTOBUF_FIELD_OFFSET(::flow_v2, _impl_.end_reason_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::flow_batch, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::flow_batch, _impl_.flows_),
+  PROTOBUF_FIELD_OFFSET(::flow_batch, _impl_.sent_),
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, -1, -1, sizeof(::pack_v2)},
+  { 16, -1, -1, sizeof(::pack_batch)},
+  { 24, -1, -1, sizeof(::flow_v2)},
+  { 43, -1, -1, sizeof(::flow_batch)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::_pack_v2_default_instance_._instance,
+  &::_pack_batch_default_instance_._instance,
+  &::_flow_v2_default_instance_._instance,
+  &::_flow_batch_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_pack_5fv2_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\rpack_v2.proto\"\255\001\n\007pack_v2\022\014\n\004time\030\001 \001("
+  "\006\022\021\n\tframeSize\030\002 \001(\r\022\014\n\004macs\030\003 \001(\014\022\013\n\003IP"
+  "v\030\005 \001(\r\022\r\n\005s_ip4\030\006 \001(\007\022\r\n\005d_ip4\030\007 \001(\007\022\r\n"
+  "\005s_ip6\030\010 \001(\014\022\r\n\005d_ip6\030\t \001(\014\022\033\n\007t_proto\030\n"
+  " \001(\0162\n.transport\022\r\n\005ports\030\013 \001(\007\"3\n\npack_"
+  "batch\022\027\n\005packs\030\001 \003(\0132\010.pack_v2\022\014\n\004sent\030\002"
+  " \001(\006\"\342\001\n\007flow_v2\022\r\n\005first\030\001 \001(\006\022\014\n\004last\030"
+  "\002 \001(\006\022\017\n\007packets\030\003 \001(\004\022\r\n\005bytes\030\004 \001(\004\022\013\n"
+  "\003IPv\030\005 \001(\r\022\r\n\005s_ip4\030\006 \001(\007\022\r\n\005d_ip4\030\007 \001(\007"
+  "\022\r\n\005s_ip6\030\010 \001(\014\022\r\n\005d_ip6\030\t \001(\014\022\033\n\007t_prot"
+  "o\030\n \001(\0162\n.transport\022\r\n\005ports\030\013 \001(\007\022\021\n\ttc"
+  "p_flags\030\014 \001(\r\022\022\n\nend_reason\030\r \001(\r\"3\n\nflo"
+  "w_batch\022\027\n\005flows\030\001 \003(\0132\010.flow_v2\022\014\n\004sent"
+  "\030\002 \001(\006*5\n\ttransport\022\020\n\014TR_UNDEFINED\020\000\022\n\n"
+  "\006TR_TCP\020\006\022\n\n\006TR_UDP\020\021B\003\370\001\001b\006proto3"
+  ;
+static ::_pbi::once_flag descriptor_table_pack_5fv2_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_pack_5fv2_2eproto = {
+    false, false, 594, descriptor_table_protodef_pack_5fv2_2eproto,
+    "pack_v2.proto",
+    &descriptor_table_pack_5fv2_2eproto_once, nullptr, 0, 4,
+    schemas, file_default_instances, TableStruct_pack_5fv2_2eproto::offsets,
+    file_level_metadata_pack_5fv2_2eproto, file_level_enum_descriptors_pack_5fv2_2eproto,
+    file_level_service_descriptors_pack_5fv2_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_pack_5fv2_2eproto_getter() {
+  return &descriptor_table_pack_5fv2_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_pack_5fv2_2eproto(&descriptor_table_pack_5fv2_2eproto);
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* transport_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_pack_5fv2_2eproto);
+  return file_level_enum_descriptors_pack_5fv2_2eproto[0];
+}
+bool transport_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 6:
+    case 17:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+// ===================================================================
+
+class pack_v2::_Internal {
+ public:
+};
+
+pack_v2::pack_v2(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:pack_v2)
+}
+pack_v2::pack_v2(const pack_v2& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  pack_v2* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.macs_){}
+    , decltype(_impl_.s_ip6_){}
+    , decltype(_impl_.d_ip6_){}
+    , decltype(_impl_.time_){}
+    , decltype(_impl_.framesize_){}
+    , decltype(_impl_.ipv_){}
+    , decltype(_impl_.s_ip4_){}
+    , decltype(_impl_.d_ip4_){}
+    , decltype(_impl_.t_proto_){}
+    , decltype(_impl_.ports_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.macs_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.macs_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_macs().empty()) {
+    _this->_impl_.macs_.Set(from._internal_macs(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.s_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.s_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_s_ip6().empty()) {
+    _this->_impl_.s_ip6_.Set(from._internal_s_ip6(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.d_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.d_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_d_ip6().empty()) {
+    _this->_impl_.d_ip6_.Set(from._internal_d_ip6(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.time_, &from._impl_.time_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.ports_) -
+    reinterpret_cast<char*>(&_impl_.time_)) + sizeof(_impl_.ports_));
+  // @@protoc_insertion_point(copy_constructor:pack_v2)
+}
+
+inline void pack_v2::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.macs_){}
+    , decltype(_impl_.s_ip6_){}
+    , decltype(_impl_.d_ip6_){}
+    , decltype(_impl_.time_){uint64_t{0u}}
+    , decltype(_impl_.framesize_){0u}
+    , decltype(_impl_.ipv_){0u}
+    , decltype(_impl_.s_ip4_){0u}
+    , decltype(_impl_.d_ip4_){0u}
+    , decltype(_impl_.t_proto_){0}
+    , decltype(_impl_.ports_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.macs_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.macs_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.s_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.s_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.d_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.d_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+pack_v2::~pack_v2() {
+  // @@protoc_insertion_point(destructor:pack_v2)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void pack_v2::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.macs_.Destroy();
+  _impl_.s_ip6_.Destroy();
+  _impl_.d_ip6_.Destroy();
+}
+
+void pack_v2::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void pack_v2::Clear() {
+// @@protoc_insertion_point(message_clear_start:pack_v2)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.macs_.ClearToEmpty();
+  _impl_.s_ip6_.ClearToEmpty();
+  _impl_.d_ip6_.ClearToEmpty();
+  ::memset(&_impl_.time_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.ports_) -
+      reinterpret_cast<char*>(&_impl_.time_)) + sizeof(_impl_.ports_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* pack_v2::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // fixed64 time = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _impl_.time_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint64_t>(ptr);
+          ptr += sizeof(uint64_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 frameSize = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.framesize_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bytes macs = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          auto str = _internal_mutable_macs();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 IPv = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.ipv_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed32 s_ip4 = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 53)) {
+          _impl_.s_ip4_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint32_t>(ptr);
+          ptr += sizeof(uint32_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed32 d_ip4 = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 61)) {
+          _impl_.d_ip4_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint32_t>(ptr);
+          ptr += sizeof(uint32_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // bytes s_ip6 = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 66)) {
+          auto str = _internal_mutable_s_ip6();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bytes d_ip6 = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 74)) {
+          auto str = _internal_mutable_d_ip6();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // .transport t_proto = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 80)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_t_proto(static_cast<::transport>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed32 ports = 11;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 93)) {
+          _impl_.ports_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint32_t>(ptr);
+          ptr += sizeof(uint32_t);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* pack_v2::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:pack_v2)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // fixed64 time = 1;
+  if (this->_internal_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed64ToArray(1, this->_internal_time(), target);
+  }
+
+  // uint32 frameSize = 2;
+  if (this->_internal_framesize() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_framesize(), target);
+  }
+
+  // bytes macs = 3;
+  if (!this->_internal_macs().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        3, this->_internal_macs(), target);
+  }
+
+  // uint32 IPv = 5;
+  if (this->_internal_ipv() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_ipv(), target);
+  }
+
+  // fixed32 s_ip4 = 6;
+  if (this->_internal_s_ip4() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed32ToArray(6, this->_internal_s_ip4(), target);
+  }
+
+  // fixed32 d_ip4 = 7;
+  if (this->_internal_d_ip4() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed32ToArray(7, this->_internal_d_ip4(), target);
+  }
+
+  // bytes s_ip6 = 8;
+  if (!this->_internal_s_ip6().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        8, this->_internal_s_ip6(), target);
+  }
+
+  // bytes d_ip6 = 9;
+  if (!this->_internal_d_ip6().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        9, this->_internal_d_ip6(), target);
+  }
+
+  // .transport t_proto = 10;
+  if (this->_internal_t_proto() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      10, this->_internal_t_proto(), target);
+  }
+
+  // fixed32 ports = 11;
+  if (this->_internal_ports() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed32ToArray(11, this->_internal_ports(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:pack_v2)
+  return target;
+}
+
+size_t pack_v2::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:pack_v2)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // bytes macs = 3;
+  if (!this->_internal_macs().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_macs());
+  }
+
+  // bytes s_ip6 = 8;
+  if (!this->_internal_s_ip6().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_s_ip6());
+  }
+
+  // bytes d_ip6 = 9;
+  if (!this->_internal_d_ip6().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_d_ip6());
+  }
+
+  // fixed64 time = 1;
+  if (this->_internal_time() != 0) {
+    total_size += 1 + 8;
+  }
+
+  // uint32 frameSize = 2;
+  if (this->_internal_framesize() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_framesize());
+  }
+
+  // uint32 IPv = 5;
+  if (this->_internal_ipv() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_ipv());
+  }
+
+  // fixed32 s_ip4 = 6;
+  if (this->_internal_s_ip4() != 0) {
+    total_size += 1 + 4;
+  }
+
+  // fixed32 d_ip4 = 7;
+  if (this->_internal_d_ip4() != 0) {
+    total_size += 1 + 4;
+  }
+
+  // .transport t_proto = 10;
+  if (this->_internal_t_proto() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_t_proto());
+  }
+
+  // fixed32 ports = 11;
+  if (this->_internal_ports() != 0) {
+    total_size += 1 + 4;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData pack_v2::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    pack_v2::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*pack_v2::GetClassData() const { return &_class_data_; }
+
+
+void pack_v2::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<pack_v2*>(&to_msg);
+  auto& from = static_cast<const pack_v2&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:pack_v2)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_macs().empty()) {
+    _this->_internal_set_macs(from._internal_macs());
+  }
+  if (!from._internal_s_ip6().empty()) {
+    _this->_internal_set_s_ip6(from._internal_s_ip6());
+  }
+  if (!from._internal_d_ip6().empty()) {
+    _this->_internal_set_d_ip6(from._internal_d_ip6());
+  }
+  if (from._internal_time() != 0) {
+    _this->_internal_set_time(from._internal_time());
+  }
+  if (from._internal_framesize() != 0) {
+    _this->_internal_set_framesize(from._internal_framesize());
+  }
+  if (from._internal_ipv() != 0) {
+    _this->_internal_set_ipv(from._internal_ipv());
+  }
+  if (from._internal_s_ip4() != 0) {
+    _this->_internal_set_s_ip4(from._internal_s_ip4());
+  }
+  if (from._internal_d_ip4() != 0) {
+    _this->_internal_set_d_ip4(from._internal_d_ip4());
+  }
+  if (from._internal_t_proto() != 0) {
+    _this->_internal_set_t_proto(from._internal_t_proto());
+  }
+  if (from._internal_ports() != 0) {
+    _this->_internal_set_ports(from._internal_ports());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void pack_v2::CopyFrom(const pack_v2& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:pack_v2)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool pack_v2::IsInitialized() const {
+  return true;
+}
+
+void pack_v2::InternalSwap(pack_v2* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.macs_, lhs_arena,
+      &other->_impl_.macs_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.s_ip6_, lhs_arena,
+      &other->_impl_.s_ip6_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.d_ip6_, lhs_arena,
+      &other->_impl_.d_ip6_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(pack_v2, _impl_.ports_)
+      + sizeof(pack_v2::_impl_.ports_)
+      - PROTOBUF_FIELD_OFFSET(pack_v2, _impl_.time_)>(
+          reinterpret_cast<char*>(&_impl_.time_),
+          reinterpret_cast<char*>(&other->_impl_.time_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata pack_v2::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_pack_5fv2_2eproto_getter, &descriptor_table_pack_5fv2_2eproto_once,
+      file_level_metadata_pack_5fv2_2eproto[0]);
+}
+
+// ===================================================================
+
+class pack_batch::_Internal {
+ public:
+};
+
+pack_batch::pack_batch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:pack_batch)
+}
+pack_batch::pack_batch(const pack_batch& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  pack_batch* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.packs_){from._impl_.packs_}
+    , decltype(_impl_.sent_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.sent_ = from._impl_.sent_;
+  // @@protoc_insertion_point(copy_constructor:pack_batch)
+}
+
+inline void pack_batch::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.packs_){arena}
+    , decltype(_impl_.sent_){uint64_t{0u}}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+pack_batch::~pack_batch() {
+  // @@protoc_insertion_point(destructor:pack_batch)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void pack_batch::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.packs_.~RepeatedPtrField();
+}
+
+void pack_batch::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void pack_batch::Clear() {
+// @@protoc_insertion_point(message_clear_start:pack_batch)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.packs_.Clear();
+  _impl_.sent_ = uint64_t{0u};
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* pack_batch::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated .pack_v2 packs = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_packs(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed64 sent = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _impl_.sent_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint64_t>(ptr);
+          ptr += sizeof(uint64_t);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* pack_batch::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:pack_batch)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .pack_v2 packs = 1;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_packs_size()); i < n; i++) {
+    const auto& repfield = this->_internal_packs(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(1, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // fixed64 sent = 2;
+  if (this->_internal_sent() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed64ToArray(2, this->_internal_sent(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:pack_batch)
+  return target;
+}
+
+size_t pack_batch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:pack_batch)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .pack_v2 packs = 1;
+  total_size += 1UL * this->_internal_packs_size();
+  for (const auto& msg : this->_impl_.packs_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // fixed64 sent = 2;
+  if (this->_internal_sent() != 0) {
+    total_size += 1 + 8;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData pack_batch::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    pack_batch::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*pack_batch::GetClassData() const { return &_class_data_; }
+
+
+void pack_batch::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<pack_batch*>(&to_msg);
+  auto& from = static_cast<const pack_batch&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:pack_batch)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.packs_.MergeFrom(from._impl_.packs_);
+  if (from._internal_sent() != 0) {
+    _this->_internal_set_sent(from._internal_sent());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void pack_batch::CopyFrom(const pack_batch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:pack_batch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool pack_batch::IsInitialized() const {
+  return true;
+}
+
+void pack_batch::InternalSwap(pack_batch* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.packs_.InternalSwap(&other->_impl_.packs_);
+  swap(_impl_.sent_, other->_impl_.sent_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata pack_batch::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_pack_5fv2_2eproto_getter, &descriptor_table_pack_5fv2_2eproto_once,
+      file_level_metadata_pack_5fv2_2eproto[1]);
+}
+
+// ===================================================================
+
+class flow_v2::_Internal {
+ public:
+};
+
+flow_v2::flow_v2(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:flow_v2)
+}
+flow_v2::flow_v2(const flow_v2& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  flow_v2* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.s_ip6_){}
+    , decltype(_impl_.d_ip6_){}
+    , decltype(_impl_.first_){}
+    , decltype(_impl_.last_){}
+    , decltype(_impl_.packets_){}
+    , decltype(_impl_.bytes_){}
+    , decltype(_impl_.ipv_){}
+    , decltype(_impl_.s_ip4_){}
+    , decltype(_impl_.d_ip4_){}
+    , decltype(_impl_.t_proto_){}
+    , decltype(_impl_.ports_){}
+    , decltype(_impl_.tcp_flags_){}
+    , decltype(_impl_.end_reason_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.s_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.s_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_s_ip6().empty()) {
+    _this->_impl_.s_ip6_.Set(from._internal_s_ip6(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.d_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.d_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_d_ip6().empty()) {
+    _this->_impl_.d_ip6_.Set(from._internal_d_ip6(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.first_, &from._impl_.first_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.end_reason_) -
+    reinterpret_cast<char*>(&_impl_.first_)) + sizeof(_impl_.end_reason_));
+  // @@protoc_insertion_point(copy_constructor:flow_v2)
+}
+
+inline void flow_v2::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.s_ip6_){}
+    , decltype(_impl_.d_ip6_){}
+    , decltype(_impl_.first_){uint64_t{0u}}
+    , decltype(_impl_.last_){uint64_t{0u}}
+    , decltype(_impl_.packets_){uint64_t{0u}}
+    , decltype(_impl_.bytes_){uint64_t{0u}}
+    , decltype(_impl_.ipv_){0u}
+    , decltype(_impl_.s_ip4_){0u}
+    , decltype(_impl_.d_ip4_){0u}
+    , decltype(_impl_.t_proto_){0}
+    , decltype(_impl_.ports_){0u}
+    , decltype(_impl_.tcp_flags_){0u}
+    , decltype(_impl_.end_reason_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.s_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.s_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.d_ip6_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.d_ip6_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+flow_v2::~flow_v2() {
+  // @@protoc_insertion_point(destructor:flow_v2)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void flow_v2::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.s_ip6_.Destroy();
+  _impl_.d_ip6_.Destroy();
+}
+
+void flow_v2::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void flow_v2::Clear() {
+// @@protoc_insertion_point(message_clear_start:flow_v2)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.s_ip6_.ClearToEmpty();
+  _impl_.d_ip6_.ClearToEmpty();
+  ::memset(&_impl_.first_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.end_reason_) -
+      reinterpret_cast<char*>(&_impl_.first_)) + sizeof(_impl_.end_reason_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* flow_v2::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // fixed64 first = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _impl_.first_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint64_t>(ptr);
+          ptr += sizeof(uint64_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed64 last = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _impl_.last_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint64_t>(ptr);
+          ptr += sizeof(uint64_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint64 packets = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.packets_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint64 bytes = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.bytes_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 IPv = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.ipv_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed32 s_ip4 = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 53)) {
+          _impl_.s_ip4_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint32_t>(ptr);
+          ptr += sizeof(uint32_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed32 d_ip4 = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 61)) {
+          _impl_.d_ip4_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint32_t>(ptr);
+          ptr += sizeof(uint32_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // bytes s_ip6 = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 66)) {
+          auto str = _internal_mutable_s_ip6();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bytes d_ip6 = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 74)) {
+          auto str = _internal_mutable_d_ip6();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // .transport t_proto = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 80)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_t_proto(static_cast<::transport>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed32 ports = 11;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 93)) {
+          _impl_.ports_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint32_t>(ptr);
+          ptr += sizeof(uint32_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 tcp_flags = 12;
+      case 12:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 96)) {
+          _impl_.tcp_flags_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 end_reason = 13;
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 104)) {
+          _impl_.end_reason_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* flow_v2::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:flow_v2)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // fixed64 first = 1;
+  if (this->_internal_first() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed64ToArray(1, this->_internal_first(), target);
+  }
+
+  // fixed64 last = 2;
+  if (this->_internal_last() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed64ToArray(2, this->_internal_last(), target);
+  }
+
+  // uint64 packets = 3;
+  if (this->_internal_packets() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(3, this->_internal_packets(), target);
+  }
+
+  // uint64 bytes = 4;
+  if (this->_internal_bytes() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_bytes(), target);
+  }
+
+  // uint32 IPv = 5;
+  if (this->_internal_ipv() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_ipv(), target);
+  }
+
+  // fixed32 s_ip4 = 6;
+  if (this->_internal_s_ip4() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed32ToArray(6, this->_internal_s_ip4(), target);
+  }
+
+  // fixed32 d_ip4 = 7;
+  if (this->_internal_d_ip4() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed32ToArray(7, this->_internal_d_ip4(), target);
+  }
+
+  // bytes s_ip6 = 8;
+  if (!this->_internal_s_ip6().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        8, this->_internal_s_ip6(), target);
+  }
+
+  // bytes d_ip6 = 9;
+  if (!this->_internal_d_ip6().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        9, this->_internal_d_ip6(), target);
+  }
+
+  // .transport t_proto = 10;
+  if (this->_internal_t_proto() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      10, this->_internal_t_proto(), target);
+  }
+
+  // fixed32 ports = 11;
+  if (this->_internal_ports() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed32ToArray(11, this->_internal_ports(), target);
+  }
+
+  // uint32 tcp_flags = 12;
+  if (this->_internal_tcp_flags() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(12, this->_internal_tcp_flags(), target);
+  }
+
+  // uint32 end_reason = 13;
+  if (this->_internal_end_reason() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(13, this->_internal_end_reason(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:flow_v2)
+  return target;
+}
+
+size_t flow_v2::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:flow_v2)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // bytes s_ip6 = 8;
+  if (!this->_internal_s_ip6().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_s_ip6());
+  }
+
+  // bytes d_ip6 = 9;
+  if (!this->_internal_d_ip6().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_d_ip6());
+  }
+
+  // fixed64 first = 1;
+  if (this->_internal_first() != 0) {
+    total_size += 1 + 8;
+  }
+
+  // fixed64 last = 2;
+  if (this->_internal_last() != 0) {
+    total_size += 1 + 8;
+  }
+
+  // uint64 packets = 3;
+  if (this->_internal_packets() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_packets());
+  }
+
+  // uint64 bytes = 4;
+  if (this->_internal_bytes() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_bytes());
+  }
+
+  // uint32 IPv = 5;
+  if (this->_internal_ipv() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_ipv());
+  }
+
+  // fixed32 s_ip4 = 6;
+  if (this->_internal_s_ip4() != 0) {
+    total_size += 1 + 4;
+  }
+
+  // fixed32 d_ip4 = 7;
+  if (this->_internal_d_ip4() != 0) {
+    total_size += 1 + 4;
+  }
+
+  // .transport t_proto = 10;
+  if (this->_internal_t_proto() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_t_proto());
+  }
+
+  // fixed32 ports = 11;
+  if (this->_internal_ports() != 0) {
+    total_size += 1 + 4;
+  }
+
+  // uint32 tcp_flags = 12;
+  if (this->_internal_tcp_flags() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_tcp_flags());
+  }
+
+  // uint32 end_reason = 13;
+  if (this->_internal_end_reason() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_end_reason());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData flow_v2::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    flow_v2::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*flow_v2::GetClassData() const { return &_class_data_; }
+
+
+void flow_v2::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<flow_v2*>(&to_msg);
+  auto& from = static_cast<const flow_v2&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:flow_v2)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_s_ip6().empty()) {
+    _this->_internal_set_s_ip6(from._internal_s_ip6());
+  }
+  if (!from._internal_d_ip6().empty()) {
+    _this->_internal_set_d_ip6(from._internal_d_ip6());
+  }
+  if (from._internal_first() != 0) {
+    _this->_internal_set_first(from._internal_first());
+  }
+  if (from._internal_last() != 0) {
+    _this->_internal_set_last(from._internal_last());
+  }
+  if (from._internal_packets() != 0) {
+    _this->_internal_set_packets(from._internal_packets());
+  }
+  if (from._internal_bytes() != 0) {
+    _this->_internal_set_bytes(from._internal_bytes());
+  }
+  if (from._internal_ipv() != 0) {
+    _this->_internal_set_ipv(from._internal_ipv());
+  }
+  if (from._internal_s_ip4() != 0) {
+    _this->_internal_set_s_ip4(from._internal_s_ip4());
+  }
+  if (from._internal_d_ip4() != 0) {
+    _this->_internal_set_d_ip4(from._internal_d_ip4());
+  }
+  if (from._internal_t_proto() != 0) {
+    _this->_internal_set_t_proto(from._internal_t_proto());
+  }
+  if (from._internal_ports() != 0) {
+    _this->_internal_set_ports(from._internal_ports());
+  }
+  if (from._internal_tcp_flags() != 0) {
+    _this->_internal_set_tcp_flags(from._internal_tcp_flags());
+  }
+  if (from._internal_end_reason() != 0) {
+    _this->_internal_set_end_reason(from._internal_end_reason());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void flow_v2::CopyFrom(const flow_v2& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:flow_v2)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool flow_v2::IsInitialized() const {
+  return true;
+}
+
+void flow_v2::InternalSwap(flow_v2* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.s_ip6_, lhs_arena,
+      &other->_impl_.s_ip6_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.d_ip6_, lhs_arena,
+      &other->_impl_.d_ip6_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(flow_v2, _impl_.end_reason_)
+      + sizeof(flow_v2::_impl_.end_reason_)
+      - PROTOBUF_FIELD_OFFSET(flow_v2, _impl_.first_)>(
+          reinterpret_cast<char*>(&_impl_.first_),
+          reinterpret_cast<char*>(&other->_impl_.first_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata flow_v2::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_pack_5fv2_2eproto_getter, &descriptor_table_pack_5fv2_2eproto_once,
+      file_level_metadata_pack_5fv2_2eproto[2]);
+}
+
+// ===================================================================
+
+class flow_batch::_Internal {
+ public:
+};
+
+flow_batch::flow_batch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:flow_batch)
+}
+flow_batch::flow_batch(const flow_batch& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  flow_batch* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.flows_){from._impl_.flows_}
+    , decltype(_impl_.sent_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.sent_ = from._impl_.sent_;
+  // @@protoc_insertion_point(copy_constructor:flow_batch)
+}
+
+inline void flow_batch::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.flows_){arena}
+    , decltype(_impl_.sent_){uint64_t{0u}}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+flow_batch::~flow_batch() {
+  // @@protoc_insertion_point(destructor:flow_batch)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void flow_batch::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.flows_.~RepeatedPtrField();
+}
+
+void flow_batch::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void flow_batch::Clear() {
+// @@protoc_insertion_point(message_clear_start:flow_batch)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.flows_.Clear();
+  _impl_.sent_ = uint64_t{0u};
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* flow_batch::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated .flow_v2 flows = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_flows(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed64 sent = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _impl_.sent_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint64_t>(ptr);
+          ptr += sizeof(uint64_t);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* flow_batch::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:flow_batch)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .flow_v2 flows = 1;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_flows_size()); i < n; i++) {
+    const auto& repfield = this->_internal_flows(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(1, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // fixed64 sent = 2;
+  if (this->_internal_sent() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed64ToArray(2, this->_internal_sent(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:flow_batch)
+  return target;
+}
+
+size_t flow_batch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:flow_batch)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .flow_v2 flows = 1;
+  total_size += 1UL * this->_internal_flows_size();
+  for (const auto& msg : this->_impl_.flows_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // fixed64 sent = 2;
+  if (this->_internal_sent() != 0) {
+    total_size += 1 + 8;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData flow_batch::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    flow_batch::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*flow_batch::GetClassData() const { return &_class_data_; }
+
+
+void flow_batch::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<flow_batch*>(&to_msg);
+  auto& from = static_cast<const flow_batch&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:flow_batch)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.flows_.MergeFrom(from._impl_.flows_);
+  if (from._internal_sent() != 0) {
+    _this->_internal_set_sent(from._internal_sent());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void flow_batch::CopyFrom(const flow_batch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:flow_batch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool flow_batch::IsInitialized() const {
+  return true;
+}
+
+void flow_batch::InternalSwap(flow_batch* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.flows_.InternalSwap(&other->_impl_.flows_);
+  swap(_impl_.sent_, other->_impl_.sent_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata flow_batch::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_pack_5fv2_2eproto_getter, &descriptor_table_pack_5fv2_2eproto_once,
+      file_level_metadata_pack_5fv2_2eproto[3]);
+}
+
+// @@protoc_insertion_point(namespace_scope)
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::pack_v2*
+Arena::CreateMaybeMessage< ::pack_v2 >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::pack_v2 >(arena);
+}
+template<> PROTOBUF_NOINLINE ::pack_batch*
+Arena::CreateMaybeMessage< ::pack_batch >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::pack_batch >(arena);
+}
+template<> PROTOBUF_NOINLINE ::flow_v2*
+Arena::CreateMaybeMessage< ::flow_v2 >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::flow_v2 >(arena);
+}
+template<> PROTOBUF_NOINLINE ::flow_batch*
+Arena::CreateMaybeMessage< ::flow_batch >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::flow_batch >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
@@ -0,0 +1,1760 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: pack_v2.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_pack_5fv2_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_pack_5fv2_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/generated_enum_reflection.h>
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_pack_5fv2_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_pack_5fv2_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_pack_5fv2_2eproto;
+class flow_batch;
+struct flow_batchDefaultTypeInternal;
+extern flow_batchDefaultTypeInternal _flow_batch_default_instance_;
+class flow_v2;
+struct flow_v2DefaultTypeInternal;
+extern flow_v2DefaultTypeInternal _flow_v2_default_instance_;
+class pack_batch;
+struct pack_batchDefaultTypeInternal;
+extern pack_batchDefaultTypeInternal _pack_batch_default_instance_;
+class pack_v2;
+struct pack_v2DefaultTypeInternal;
+extern pack_v2DefaultTypeInternal _pack_v2_default_instance_;
+PROTOBUF_NAMESPACE_OPEN
+template<> ::flow_batch* Arena::CreateMaybeMessage<::flow_batch>(Arena*);
+template<> ::flow_v2* Arena::CreateMaybeMessage<::flow_v2>(Arena*);
+template<> ::pack_batch* Arena::CreateMaybeMessage<::pack_batch>(Arena*);
+template<> ::pack_v2* Arena::CreateMaybeMessage<::pack_v2>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+
+enum transport : int {
+  TR_UNDEFINED = 0,
+  TR_TCP = 6,
+  TR_UDP = 17,
+  transport_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  transport_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool transport_IsValid(int value);
+constexpr transport transport_MIN = TR_UNDEFINED;
+constexpr transport transport_MAX = TR_UDP;
+constexpr int transport_ARRAYSIZE = transport_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* transport_descriptor();
+template<typename T>
+inline const std::string& transport_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, transport>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function transport_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    transport_descriptor(), enum_t_value);
+}
+inline bool transport_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, transport* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<transport>(
+    transport_descriptor(), name, value);
+}
+// ===================================================================
+
+class pack_v2 final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:pack_v2) */ {
+ public:
+  inline pack_v2() : pack_v2(nullptr) {}
+  ~pack_v2() override;
+  explicit PROTOBUF_CONSTEXPR pack_v2(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  pack_v2(const pack_v2& from);
+  pack_v2(pack_v2&& from) noexcept
+    : pack_v2() {
+    *this = ::std::move(from);
+  }
+
+  inline pack_v2& operator=(const pack_v2& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline pack_v2& operator=(pack_v2&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const pack_v2& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const pack_v2* internal_default_instance() {
+    return reinterpret_cast<const pack_v2*>(
+               &_pack_v2_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(pack_v2& a, pack_v2& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(pack_v2* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(pack_v2* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  pack_v2* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<pack_v2>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const pack_v2& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const pack_v2& from) {
+    pack_v2::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(pack_v2* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "pack_v2";
+  }
+  protected:
+  explicit pack_v2(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMacsFieldNumber = 3,
+    kSIp6FieldNumber = 8,
+    kDIp6FieldNumber = 9,
+    kTimeFieldNumber = 1,
+    kFrameSizeFieldNumber = 2,
+    kIPvFieldNumber = 5,
+    kSIp4FieldNumber = 6,
+    kDIp4FieldNumber = 7,
+    kTProtoFieldNumber = 10,
+    kPortsFieldNumber = 11,
+  };
+  // bytes macs = 3;
+  void clear_macs();
+  const std::string& macs() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_macs(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_macs();
+  PROTOBUF_NODISCARD std::string* release_macs();
+  void set_allocated_macs(std::string* macs);
+  private:
+  const std::string& _internal_macs() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_macs(const std::string& value);
+  std::string* _internal_mutable_macs();
+  public:
+
+  // bytes s_ip6 = 8;
+  void clear_s_ip6();
+  const std::string& s_ip6() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_s_ip6(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_s_ip6();
+  PROTOBUF_NODISCARD std::string* release_s_ip6();
+  void set_allocated_s_ip6(std::string* s_ip6);
+  private:
+  const std::string& _internal_s_ip6() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_s_ip6(const std::string& value);
+  std::string* _internal_mutable_s_ip6();
+  public:
+
+  // bytes d_ip6 = 9;
+  void clear_d_ip6();
+  const std::string& d_ip6() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_d_ip6(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_d_ip6();
+  PROTOBUF_NODISCARD std::string* release_d_ip6();
+  void set_allocated_d_ip6(std::string* d_ip6);
+  private:
+  const std::string& _internal_d_ip6() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_d_ip6(const std::string& value);
+  std::string* _internal_mutable_d_ip6();
+  public:
+
+  // fixed64 time = 1;
+  void clear_time();
+  uint64_t time() const;
+  void set_time(uint64_t value);
+  private:
+  uint64_t _internal_time() const;
+  void _internal_set_time(uint64_t value);
+  public:
+
+  // uint32 frameSize = 2;
+  void clear_framesize();
+  uint32_t framesize() const;
+  void set_framesize(uint32_t value);
+  private:
+  uint32_t _internal_framesize() const;
+  void _internal_set_framesize(uint32_t value);
+  public:
+
+  // uint32 IPv = 5;
+  void clear_ipv();
+  uint32_t ipv() const;
+  void set_ipv(uint32_t value);
+  private:
+  uint32_t _internal_ipv() const;
+  void _internal_set_ipv(uint32_t value);
+  public:
+
+  // fixed32 s_ip4 = 6;
+  void clear_s_ip4();
+  uint32_t s_ip4() const;
+  void set_s_ip4(uint32_t value);
+  private:
+  uint32_t _internal_s_ip4() const;
+  void _internal_set_s_ip4(uint32_t value);
+  public:
+
+  // fixed32 d_ip4 = 7;
+  void clear_d_ip4();
+  uint32_t d_ip4() const;
+  void set_d_ip4(uint32_t value);
+  private:
+  uint32_t _internal_d_ip4() const;
+  void _internal_set_d_ip4(uint32_t value);
+  public:
+
+  // .transport t_proto = 10;
+  void clear_t_proto();
+  ::transport t_proto() const;
+  void set_t_proto(::transport value);
+  private:
+  ::transport _internal_t_proto() const;
+  void _internal_set_t_proto(::transport value);
+  public:
+
+  // fixed32 ports = 11;
+  void clear_ports();
+  uint32_t ports() const;
+  void set_ports(uint32_t value);
+  private:
+  uint32_t _internal_ports() const;
+  void _internal_set_ports(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:pack_v2)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr macs_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr s_ip6_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr d_ip6_;
+    uint64_t time_;
+    uint32_t framesize_;
+    uint32_t ipv_;
+    uint32_t s_ip4_;
+    uint32_t d_ip4_;
+    int t_proto_;
+    uint32_t ports_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_pack_5fv2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class pack_batch final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:pack_batch) */ {
+ public:
+  inline pack_batch() : pack_batch(nullptr) {}
+  ~pack_batch() override;
+  explicit PROTOBUF_CONSTEXPR pack_batch(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  pack_batch(const pack_batch& from);
+  pack_batch(pack_batch&& from) noexcept
+    : pack_batch() {
+    *this = ::std::move(from);
+  }
+
+  inline pack_batch& operator=(const pack_batch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline pack_batch& operator=(pack_batch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const pack_batch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const pack_batch* internal_default_instance() {
+    return reinterpret_cast<const pack_batch*>(
+               &_pack_batch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(pack_batch& a, pack_batch& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(pack_batch* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(pack_batch* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  pack_batch* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<pack_batch>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const pack_batch& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const pack_batch& from) {
+    pack_batch::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(pack_batch* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "pack_batch";
+  }
+  protected:
+  explicit pack_batch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kPacksFieldNumber = 1,
+    kSentFieldNumber = 2,
+  };
+  // repeated .pack_v2 packs = 1;
+  int packs_size() const;
+  private:
+  int _internal_packs_size() const;
+  public:
+  void clear_packs();
+  ::pack_v2* mutable_packs(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pack_v2 >*
+      mutable_packs();
+  private:
+  const ::pack_v2& _internal_packs(int index) const;
+  ::pack_v2* _internal_add_packs();
+  public:
+  const ::pack_v2& packs(int index) const;
+  ::pack_v2* add_packs();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pack_v2 >&
+      packs() const;
+
+  // fixed64 sent = 2;
+  void clear_sent();
+  uint64_t sent() const;
+  void set_sent(uint64_t value);
+  private:
+  uint64_t _internal_sent() const;
+  void _internal_set_sent(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:pack_batch)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pack_v2 > packs_;
+    uint64_t sent_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_pack_5fv2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class flow_v2 final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:flow_v2) */ {
+ public:
+  inline flow_v2() : flow_v2(nullptr) {}
+  ~flow_v2() override;
+  explicit PROTOBUF_CONSTEXPR flow_v2(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  flow_v2(const flow_v2& from);
+  flow_v2(flow_v2&& from) noexcept
+    : flow_v2() {
+    *this = ::std::move(from);
+  }
+
+  inline flow_v2& operator=(const flow_v2& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline flow_v2& operator=(flow_v2&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const flow_v2& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const flow_v2* internal_default_instance() {
+    return reinterpret_cast<const flow_v2*>(
+               &_flow_v2_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(flow_v2& a, flow_v2& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(flow_v2* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(flow_v2* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  flow_v2* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<flow_v2>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const flow_v2& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const flow_v2& from) {
+    flow_v2::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(flow_v2* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "flow_v2";
+  }
+  protected:
+  explicit flow_v2(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kSIp6FieldNumber = 8,
+    kDIp6FieldNumber = 9,
+    kFirstFieldNumber = 1,
+    kLastFieldNumber = 2,
+    kPacketsFieldNumber = 3,
+    kBytesFieldNumber = 4,
+    kIPvFieldNumber = 5,
+    kSIp4FieldNumber = 6,
+    kDIp4FieldNumber = 7,
+    kTProtoFieldNumber = 10,
+    kPortsFieldNumber = 11,
+    kTcpFlagsFieldNumber = 12,
+    kEndReasonFieldNumber = 13,
+  };
+  // bytes s_ip6 = 8;
+  void clear_s_ip6();
+  const std::string& s_ip6() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_s_ip6(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_s_ip6();
+  PROTOBUF_NODISCARD std::string* release_s_ip6();
+  void set_allocated_s_ip6(std::string* s_ip6);
+  private:
+  const std::string& _internal_s_ip6() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_s_ip6(const std::string& value);
+  std::string* _internal_mutable_s_ip6();
+  public:
+
+  // bytes d_ip6 = 9;
+  void clear_d_ip6();
+  const std::string& d_ip6() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_d_ip6(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_d_ip6();
+  PROTOBUF_NODISCARD std::string* release_d_ip6();
+  void set_allocated_d_ip6(std::string* d_ip6);
+  private:
+  const std::string& _internal_d_ip6() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_d_ip6(const std::string& value);
+  std::string* _internal_mutable_d_ip6();
+  public:
+
+  // fixed64 first = 1;
+  void clear_first();
+  uint64_t first() const;
+  void set_first(uint64_t value);
+  private:
+  uint64_t _internal_first() const;
+  void _internal_set_first(uint64_t value);
+  public:
+
+  // fixed64 last = 2;
+  void clear_last();
+  uint64_t last() const;
+  void set_last(uint64_t value);
+  private:
+  uint64_t _internal_last() const;
+  void _internal_set_last(uint64_t value);
+  public:
+
+  // uint64 packets = 3;
+  void clear_packets();
+  uint64_t packets() const;
+  void set_packets(uint64_t value);
+  private:
+  uint64_t _internal_packets() const;
+  void _internal_set_packets(uint64_t value);
+  public:
+
+  // uint64 bytes = 4;
+  void clear_bytes();
+  uint64_t bytes() const;
+  void set_bytes(uint64_t value);
+  private:
+  uint64_t _internal_bytes() const;
+  void _internal_set_bytes(uint64_t value);
+  public:
+
+  // uint32 IPv = 5;
+  void clear_ipv();
+  uint32_t ipv() const;
+  void set_ipv(uint32_t value);
+  private:
+  uint32_t _internal_ipv() const;
+  void _internal_set_ipv(uint32_t value);
+  public:
+
+  // fixed32 s_ip4 = 6;
+  void clear_s_ip4();
+  uint32_t s_ip4() const;
+  void set_s_ip4(uint32_t value);
+  private:
+  uint32_t _internal_s_ip4() const;
+  void _internal_set_s_ip4(uint32_t value);
+  public:
+
+  // fixed32 d_ip4 = 7;
+  void clear_d_ip4();
+  uint32_t d_ip4() const;
+  void set_d_ip4(uint32_t value);
+  private:
+  uint32_t _internal_d_ip4() const;
+  void _internal_set_d_ip4(uint32_t value);
+  public:
+
+  // .transport t_proto = 10;
+  void clear_t_proto();
+  ::transport t_proto() const;
+  void set_t_proto(::transport value);
+  private:
+  ::transport _internal_t_proto() const;
+  void _internal_set_t_proto(::transport value);
+  public:
+
+  // fixed32 ports = 11;
+  void clear_ports();
+  uint32_t ports() const;
+  void set_ports(uint32_t value);
+  private:
+  uint32_t _internal_ports() const;
+  void _internal_set_ports(uint32_t value);
+  public:
+
+  // uint32 tcp_flags = 12;
+  void clear_tcp_flags();
+  uint32_t tcp_flags() const;
+  void set_tcp_flags(uint32_t value);
+  private:
+  uint32_t _internal_tcp_flags() const;
+  void _internal_set_tcp_flags(uint32_t value);
+  public:
+
+  // uint32 end_reason = 13;
+  void clear_end_reason();
+  uint32_t end_reason() const;
+  void set_end_reason(uint32_t value);
+  private:
+  uint32_t _internal_end_reason() const;
+  void _internal_set_end_reason(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:flow_v2)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr s_ip6_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr d_ip6_;
+    uint64_t first_;
+    uint64_t last_;
+    uint64_t packets_;
+    uint64_t bytes_;
+    uint32_t ipv_;
+    uint32_t s_ip4_;
+    uint32_t d_ip4_;
+    int t_proto_;
+    uint32_t ports_;
+    uint32_t tcp_flags_;
+    uint32_t end_reason_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_pack_5fv2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class flow_batch final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:flow_batch) */ {
+ public:
+  inline flow_batch() : flow_batch(nullptr) {}
+  ~flow_batch() override;
+  explicit PROTOBUF_CONSTEXPR flow_batch(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  flow_batch(const flow_batch& from);
+  flow_batch(flow_batch&& from) noexcept
+    : flow_batch() {
+    *this = ::std::move(from);
+  }
+
+  inline flow_batch& operator=(const flow_batch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline flow_batch& operator=(flow_batch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const flow_batch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const flow_batch* internal_default_instance() {
+    return reinterpret_cast<const flow_batch*>(
+               &_flow_batch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(flow_batch& a, flow_batch& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(flow_batch* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(flow_batch* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  flow_batch* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<flow_batch>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const flow_batch& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const flow_batch& from) {
+    flow_batch::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(flow_batch* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "flow_batch";
+  }
+  protected:
+  explicit flow_batch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kFlowsFieldNumber = 1,
+    kSentFieldNumber = 2,
+  };
+  // repeated .flow_v2 flows = 1;
+  int flows_size() const;
+  private:
+  int _internal_flows_size() const;
+  public:
+  void clear_flows();
+  ::flow_v2* mutable_flows(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::flow_v2 >*
+      mutable_flows();
+  private:
+  const ::flow_v2& _internal_flows(int index) const;
+  ::flow_v2* _internal_add_flows();
+  public:
+  const ::flow_v2& flows(int index) const;
+  ::flow_v2* add_flows();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::flow_v2 >&
+      flows() const;
+
+  // fixed64 sent = 2;
+  void clear_sent();
+  uint64_t sent() const;
+  void set_sent(uint64_t value);
+  private:
+  uint64_t _internal_sent() const;
+  void _internal_set_sent(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:flow_batch)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::flow_v2 > flows_;
+    uint64_t sent_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_pack_5fv2_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// pack_v2
+
+// fixed64 time = 1;
+inline void pack_v2::clear_time() {
+  _impl_.time_ = uint64_t{0u};
+}
+inline uint64_t pack_v2::_internal_time() const {
+  return _impl_.time_;
+}
+inline uint64_t pack_v2::time() const {
+  // @@protoc_insertion_point(field_get:pack_v2.time)
+  return _internal_time();
+}
+inline void pack_v2::_internal_set_time(uint64_t value) {
+  
+  _impl_.time_ = value;
+}
+inline void pack_v2::set_time(uint64_t value) {
+  _internal_set_time(value);
+  // @@protoc_insertion_point(field_set:pack_v2.time)
+}
+
+// uint32 frameSize = 2;
+inline void pack_v2::clear_framesize() {
+  _impl_.framesize_ = 0u;
+}
+inline uint32_t pack_v2::_internal_framesize() const {
+  return _impl_.framesize_;
+}
+inline uint32_t pack_v2::framesize() const {
+  // @@protoc_insertion_point(field_get:pack_v2.frameSize)
+  return _internal_framesize();
+}
+inline void pack_v2::_internal_set_framesize(uint32_t value) {
+  
+  _impl_.framesize_ = value;
+}
+inline void pack_v2::set_framesize(uint32_t value) {
+  _internal_set_framesize(value);
+  // @@protoc_insertion_point(field_set:pack_v2.frameSize)
+}
+
+// bytes macs = 3;
+inline void pack_v2::clear_macs() {
+  _impl_.macs_.ClearToEmpty();
+}
+inline const std::string& pack_v2::macs() const {
+  // @@protoc_insertion_point(field_get:pack_v2.macs)
+  return _internal_macs();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void pack_v2::set_macs(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.macs_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:pack_v2.macs)
+}
+inline std::string* pack_v2::mutable_macs() {
+  std::string* _s = _internal_mutable_macs();
+  // @@protoc_insertion_point(field_mutable:pack_v2.macs)
+  return _s;
+}
+inline const std::string& pack_v2::_internal_macs() const {
+  return _impl_.macs_.Get();
+}
+inline void pack_v2::_internal_set_macs(const std::string& value) {
+  
+  _impl_.macs_.Set(value, GetArenaForAllocation());
+}
+inline std::string* pack_v2::_internal_mutable_macs() {
+  
+  return _impl_.macs_.Mutable(GetArenaForAllocation());
+}
+inline std::string* pack_v2::release_macs() {
+  // @@protoc_insertion_point(field_release:pack_v2.macs)
+  return _impl_.macs_.Release();
+}
+inline void pack_v2::set_allocated_macs(std::string* macs) {
+  if (macs != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.macs_.SetAllocated(macs, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.macs_.IsDefault()) {
+    _impl_.macs_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:pack_v2.macs)
+}
+
+// uint32 IPv = 5;
+inline void pack_v2::clear_ipv() {
+  _impl_.ipv_ = 0u;
+}
+inline uint32_t pack_v2::_internal_ipv() const {
+  return _impl_.ipv_;
+}
+inline uint32_t pack_v2::ipv() const {
+  // @@protoc_insertion_point(field_get:pack_v2.IPv)
+  return _internal_ipv();
+}
+inline void pack_v2::_internal_set_ipv(uint32_t value) {
+  
+  _impl_.ipv_ = value;
+}
+inline void pack_v2::set_ipv(uint32_t value) {
+  _internal_set_ipv(value);
+  // @@protoc_insertion_point(field_set:pack_v2.IPv)
+}
+
+// fixed32 s_ip4 = 6;
+inline void pack_v2::clear_s_ip4() {
+  _impl_.s_ip4_ = 0u;
+}
+inline uint32_t pack_v2::_internal_s_ip4() const {
+  return _impl_.s_ip4_;
+}
+inline uint32_t pack_v2::s_ip4() const {
+  // @@protoc_insertion_point(field_get:pack_v2.s_ip4)
+  return _internal_s_ip4();
+}
+inline void pack_v2::_internal_set_s_ip4(uint32_t value) {
+  
+  _impl_.s_ip4_ = value;
+}
+inline void pack_v2::set_s_ip4(uint32_t value) {
+  _internal_set_s_ip4(value);
+  // @@protoc_insertion_point(field_set:pack_v2.s_ip4)
+}
+
+// fixed32 d_ip4 = 7;
+inline void pack_v2::clear_d_ip4() {
+  _impl_.d_ip4_ = 0u;
+}
+inline uint32_t pack_v2::_internal_d_ip4() const {
+  return _impl_.d_ip4_;
+}
+inline uint32_t pack_v2::d_ip4() const {
+  // @@protoc_insertion_point(field_get:pack_v2.d_ip4)
+  return _internal_d_ip4();
+}
+inline void pack_v2::_internal_set_d_ip4(uint32_t value) {
+  
+  _impl_.d_ip4_ = value;
+}
+inline void pack_v2::set_d_ip4(uint32_t value) {
+  _internal_set_d_ip4(value);
+  // @@protoc_insertion_point(field_set:pack_v2.d_ip4)
+}
+
+// bytes s_ip6 = 8;
+inline void pack_v2::clear_s_ip6() {
+  _impl_.s_ip6_.ClearToEmpty();
+}
+inline const std::string& pack_v2::s_ip6() const {
+  // @@protoc_insertion_point(field_get:pack_v2.s_ip6)
+  return _internal_s_ip6();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void pack_v2::set_s_ip6(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.s_ip6_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:pack_v2.s_ip6)
+}
+inline std::string* pack_v2::mutable_s_ip6() {
+  std::string* _s = _internal_mutable_s_ip6();
+  // @@protoc_insertion_point(field_mutable:pack_v2.s_ip6)
+  return _s;
+}
+inline const std::string& pack_v2::_internal_s_ip6() const {
+  return _impl_.s_ip6_.Get();
+}
+inline void pack_v2::_internal_set_s_ip6(const std::string& value) {
+  
+  _impl_.s_ip6_.Set(value, GetArenaForAllocation());
+}
+inline std::string* pack_v2::_internal_mutable_s_ip6() {
+  
+  return _impl_.s_ip6_.Mutable(GetArenaForAllocation());
+}
+inline std::string* pack_v2::release_s_ip6() {
+  // @@protoc_insertion_point(field_release:pack_v2.s_ip6)
+  return _impl_.s_ip6_.Release();
+}
+inline void pack_v2::set_allocated_s_ip6(std::string* s_ip6) {
+  if (s_ip6 != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.s_ip6_.SetAllocated(s_ip6, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.s_ip6_.IsDefault()) {
+    _impl_.s_ip6_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:pack_v2.s_ip6)
+}
+
+// bytes d_ip6 = 9;
+inline void pack_v2::clear_d_ip6() {
+  _impl_.d_ip6_.ClearToEmpty();
+}
+inline const std::string& pack_v2::d_ip6() const {
+  // @@protoc_insertion_point(field_get:pack_v2.d_ip6)
+  return _internal_d_ip6();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void pack_v2::set_d_ip6(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.d_ip6_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:pack_v2.d_ip6)
+}
+inline std::string* pack_v2::mutable_d_ip6() {
+  std::string* _s = _internal_mutable_d_ip6();
+  // @@protoc_insertion_point(field_mutable:pack_v2.d_ip6)
+  return _s;
+}
+inline const std::string& pack_v2::_internal_d_ip6() const {
+  return _impl_.d_ip6_.Get();
+}
+inline void pack_v2::_internal_set_d_ip6(const std::string& value) {
+  
+  _impl_.d_ip6_.Set(value, GetArenaForAllocation());
+}
+inline std::string* pack_v2::_internal_mutable_d_ip6() {
+  
+  return _impl_.d_ip6_.Mutable(GetArenaForAllocation());
+}
+inline std::string* pack_v2::release_d_ip6() {
+  // @@protoc_insertion_point(field_release:pack_v2.d_ip6)
+  return _impl_.d_ip6_.Release();
+}
+inline void pack_v2::set_allocated_d_ip6(std::string* d_ip6) {
+  if (d_ip6 != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.d_ip6_.SetAllocated(d_ip6, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.d_ip6_.IsDefault()) {
+    _impl_.d_ip6_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:pack_v2.d_ip6)
+}
+
+// .transport t_proto = 10;
+inline void pack_v2::clear_t_proto() {
+  _impl_.t_proto_ = 0;
+}
+inline ::transport pack_v2::_internal_t_proto() const {
+  return static_cast< ::transport >(_impl_.t_proto_);
+}
+inline ::transport pack_v2::t_proto() const {
+  // @@protoc_insertion_point(field_get:pack_v2.t_proto)
+  return _internal_t_proto();
+}
+inline void pack_v2::_internal_set_t_proto(::transport value) {
+  
+  _impl_.t_proto_ = value;
+}
+inline void pack_v2::set_t_proto(::transport value) {
+  _internal_set_t_proto(value);
+  // @@protoc_insertion_point(field_set:pack_v2.t_proto)
+}
+
+// fixed32 ports = 11;
+inline void pack_v2::clear_ports() {
+  _impl_.ports_ = 0u;
+}
+inline uint32_t pack_v2::_internal_ports() const {
+  return _impl_.ports_;
+}
+inline uint32_t pack_v2::ports() const {
+  // @@protoc_insertion_point(field_get:pack_v2.ports)
+  return _internal_ports();
+}
+inline void pack_v2::_internal_set_ports(uint32_t value) {
+  
+  _impl_.ports_ = value;
+}
+inline void pack_v2::set_ports(uint32_t value) {
+  _internal_set_ports(value);
+  // @@protoc_insertion_point(field_set:pack_v2.ports)
+}
+
+// -------------------------------------------------------------------
+
+// pack_batch
+
+// repeated .pack_v2 packs = 1;
+inline int pack_batch::_internal_packs_size() const {
+  return _impl_.packs_.size();
+}
+inline int pack_batch::packs_size() const {
+  return _internal_packs_size();
+}
+inline void pack_batch::clear_packs() {
+  _impl_.packs_.Clear();
+}
+inline ::pack_v2* pack_batch::mutable_packs(int index) {
+  // @@protoc_insertion_point(field_mutable:pack_batch.packs)
+  return _impl_.packs_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pack_v2 >*
+pack_batch::mutable_packs() {
+  // @@protoc_insertion_point(field_mutable_list:pack_batch.packs)
+  return &_impl_.packs_;
+}
+inline const ::pack_v2& pack_batch::_internal_packs(int index) const {
+  return _impl_.packs_.Get(index);
+}
+inline const ::pack_v2& pack_batch::packs(int index) const {
+  // @@protoc_insertion_point(field_get:pack_batch.packs)
+  return _internal_packs(index);
+}
+inline ::pack_v2* pack_batch::_internal_add_packs() {
+  return _impl_.packs_.Add();
+}
+inline ::pack_v2* pack_batch::add_packs() {
+  ::pack_v2* _add = _internal_add_packs();
+  // @@protoc_insertion_point(field_add:pack_batch.packs)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pack_v2 >&
+pack_batch::packs() const {
+  // @@protoc_insertion_point(field_list:pack_batch.packs)
+  return _impl_.packs_;
+}
+
+// fixed64 sent = 2;
+inline void pack_batch::clear_sent() {
+  _impl_.sent_ = uint64_t{0u};
+}
+inline uint64_t pack_batch::_internal_sent() const {
+  return _impl_.sent_;
+}
+inline uint64_t pack_batch::sent() const {
+  // @@protoc_insertion_point(field_get:pack_batch.sent)
+  return _internal_sent();
+}
+inline void pack_batch::_internal_set_sent(uint64_t value) {
+  
+  _impl_.sent_ = value;
+}
+inline void pack_batch::set_sent(uint64_t value) {
+  _internal_set_sent(value);
+  // @@protoc_insertion_point(field_set:pack_batch.sent)
+}
+
+// -------------------------------------------------------------------
+
+// flow_v2
+
+// fixed64 first = 1;
+inline void flow_v2::clear_first() {
+  _impl_.first_ = uint64_t{0u};
+}
+inline uint64_t flow_v2::_internal_first() const {
+  return _impl_.first_;
+}
+inline uint64_t flow_v2::first() const {
+  // @@protoc_insertion_point(field_get:flow_v2.first)
+  return _internal_first();
+}
+inline void flow_v2::_internal_set_first(uint64_t value) {
+  
+  _impl_.first_ = value;
+}
+inline void flow_v2::set_first(uint64_t value) {
+  _internal_set_first(value);
+  // @@protoc_insertion_point(field_set:flow_v2.first)
+}
+
+// fixed64 last = 2;
+inline void flow_v2::clear_last() {
+  _impl_.last_ = uint64_t{0u};
+}
+inline uint64_t flow_v2::_internal_last() const {
+  return _impl_.last_;
+}
+inline uint64_t flow_v2::last() const {
+  // @@protoc_insertion_point(field_get:flow_v2.last)
+  return _internal_last();
+}
+inline void flow_v2::_internal_set_last(uint64_t value) {
+  
+  _impl_.last_ = value;
+}
+inline void flow_v2::set_last(uint64_t value) {
+  _internal_set_last(value);
+  // @@protoc_insertion_point(field_set:flow_v2.last)
+}
+
+// uint64 packets = 3;
+inline void flow_v2::clear_packets() {
+  _impl_.packets_ = uint64_t{0u};
+}
+inline uint64_t flow_v2::_internal_packets() const {
+  return _impl_.packets_;
+}
+inline uint64_t flow_v2::packets() const {
+  // @@protoc_insertion_point(field_get:flow_v2.packets)
+  return _internal_packets();
+}
+inline void flow_v2::_internal_set_packets(uint64_t value) {
+  
+  _impl_.packets_ = value;
+}
+inline void flow_v2::set_packets(uint64_t value) {
+  _internal_set_packets(value);
+  // @@protoc_insertion_point(field_set:flow_v2.packets)
+}
+
+// uint64 bytes = 4;
+inline void flow_v2::clear_bytes() {
+  _impl_.bytes_ = uint64_t{0u};
+}
+inline uint64_t flow_v2::_internal_bytes() const {
+  return _impl_.bytes_;
+}
+inline uint64_t flow_v2::bytes() const {
+  // @@protoc_insertion_point(field_get:flow_v2.bytes)
+  return _internal_bytes();
+}
+inline void flow_v2::_internal_set_bytes(uint64_t value) {
+  
+  _impl_.bytes_ = value;
+}
+inline void flow_v2::set_bytes(uint64_t value) {
+  _internal_set_bytes(value);
+  // @@protoc_insertion_point(field_set:flow_v2.bytes)
+}
+
+// uint32 IPv = 5;
+inline void flow_v2::clear_ipv() {
+  _impl_.ipv_ = 0u;
+}
+inline uint32_t flow_v2::_internal_ipv() const {
+  return _impl_.ipv_;
+}
+inline uint32_t flow_v2::ipv() const {
+  // @@protoc_insertion_point(field_get:flow_v2.IPv)
+  return _internal_ipv();
+}
+inline void flow_v2::_internal_set_ipv(uint32_t value) {
+  
+  _impl_.ipv_ = value;
+}
+inline void flow_v2::set_ipv(uint32_t value) {
+  _internal_set_ipv(value);
+  // @@protoc_insertion_point(field_set:flow_v2.IPv)
+}
+
+// fixed32 s_ip4 = 6;
+inline void flow_v2::clear_s_ip4() {
+  _impl_.s_ip4_ = 0u;
+}
+inline uint32_t flow_v2::_internal_s_ip4() const {
+  return _impl_.s_ip4_;
+}
+inline uint32_t flow_v2::s_ip4() const {
+  // @@protoc_insertion_point(field_get:flow_v2.s_ip4)
+  return _internal_s_ip4();
+}
+inline void flow_v2::_internal_set_s_ip4(uint32_t value) {
+  
+  _impl_.s_ip4_ = value;
+}
+inline void flow_v2::set_s_ip4(uint32_t value) {
+  _internal_set_s_ip4(value);
+  // @@protoc_insertion_point(field_set:flow_v2.s_ip4)
+}
+
+// fixed32 d_ip4 = 7;
+inline void flow_v2::clear_d_ip4() {
+  _impl_.d_ip4_ = 0u;
+}
+inline uint32_t flow_v2::_internal_d_ip4() const {
+  return _impl_.d_ip4_;
+}
+inline uint32_t flow_v2::d_ip4() const {
+  // @@protoc_insertion_point(field_get:flow_v2.d_ip4)
+  return _internal_d_ip4();
+}
+inline void flow_v2::_internal_set_d_ip4(uint32_t value) {
+  
+  _impl_.d_ip4_ = value;
+}
+inline void flow_v2::set_d_ip4(uint32_t value) {
+  _internal_set_d_ip4(value);
+  // @@protoc_insertion_point(field_set:flow_v2.d_ip4)
+}
+
+// bytes s_ip6 = 8;
+inline void flow_v2::clear_s_ip6() {
+  _impl_.s_ip6_.ClearToEmpty();
+}
+inline const std::string& flow_v2::s_ip6() const {
+  // @@protoc_insertion_point(field_get:flow_v2.s_ip6)
+  return _internal_s_ip6();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void flow_v2::set_s_ip6(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.s_ip6_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:flow_v2.s_ip6)
+}
+inline std::string* flow_v2::mutable_s_ip6() {
+  std::string* _s = _internal_mutable_s_ip6();
+  // @@protoc_insertion_point(field_mutable:flow_v2.s_ip6)
+  return _s;
+}
+inline const std::string& flow_v2::_internal_s_ip6() const {
+  return _impl_.s_ip6_.Get();
+}
+inline void flow_v2::_internal_set_s_ip6(const std::string& value) {
+  
+  _impl_.s_ip6_.Set(value, GetArenaForAllocation());
+}
+inline std::string* flow_v2::_internal_mutable_s_ip6() {
+  
+  return _impl_.s_ip6_.Mutable(GetArenaForAllocation());
+}
+inline std::string* flow_v2::release_s_ip6() {
+  // @@protoc_insertion_point(field_release:flow_v2.s_ip6)
+  return _impl_.s_ip6_.Release();
+}
+inline void flow_v2::set_allocated_s_ip6(std::string* s_ip6) {
+  if (s_ip6 != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.s_ip6_.SetAllocated(s_ip6, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.s_ip6_.IsDefault()) {
+    _impl_.s_ip6_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:flow_v2.s_ip6)
+}
+
+// bytes d_ip6 = 9;
+inline void flow_v2::clear_d_ip6() {
+  _impl_.d_ip6_.ClearToEmpty();
+}
+inline const std::string& flow_v2::d_ip6() const {
+  // @@protoc_insertion_point(field_get:flow_v2.d_ip6)
+  return _internal_d_ip6();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void flow_v2::set_d_ip6(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.d_ip6_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:flow_v2.d_ip6)
+}
+inline std::string* flow_v2::mutable_d_ip6() {
+  std::string* _s = _internal_mutable_d_ip6();
+  // @@protoc_insertion_point(field_mutable:flow_v2.d_ip6)
+  return _s;
+}
+inline const std::string& flow_v2::_internal_d_ip6() const {
+  return _impl_.d_ip6_.Get();
+}
+inline void flow_v2::_internal_set_d_ip6(const std::string& value) {
+  
+  _impl_.d_ip6_.Set(value, GetArenaForAllocation());
+}
+inline std::string* flow_v2::_internal_mutable_d_ip6() {
+  
+  return _impl_.d_ip6_.Mutable(GetArenaForAllocation());
+}
+inline std::string* flow_v2::release_d_ip6() {
+  // @@protoc_insertion_point(field_release:flow_v2.d_ip6)
+  return _impl_.d_ip6_.Release();
+}
+inline void flow_v2::set_allocated_d_ip6(std::string* d_ip6) {
+  if (d_ip6 != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.d_ip6_.SetAllocated(d_ip6, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.d_ip6_.IsDefault()) {
+    _impl_.d_ip6_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:flow_v2.d_ip6)
+}
+
+// .transport t_proto = 10;
+inline void flow_v2::clear_t_proto() {
+  _impl_.t_proto_ = 0;
+}
+inline ::transport flow_v2::_internal_t_proto() const {
+  return static_cast< ::transport >(_impl_.t_proto_);
+}
+inline ::transport flow_v2::t_proto() const {
+  // @@protoc_insertion_point(field_get:flow_v2.t_proto)
+  return _internal_t_proto();
+}
+inline void flow_v2::_internal_set_t_proto(::transport value) {
+  
+  _impl_.t_proto_ = value;
+}
+inline void flow_v2::set_t_proto(::transport value) {
+  _internal_set_t_proto(value);
+  // @@protoc_insertion_point(field_set:flow_v2.t_proto)
+}
+
+// fixed32 ports = 11;
+inline void flow_v2::clear_ports() {
+  _impl_.ports_ = 0u;
+}
+inline uint32_t flow_v2::_internal_ports() const {
+  return _impl_.ports_;
+}
+inline uint32_t flow_v2::ports() const {
+  // @@protoc_insertion_point(field_get:flow_v2.ports)
+  return _internal_ports();
+}
+inline void flow_v2::_internal_set_ports(uint32_t value) {
+  
+  _impl_.ports_ = value;
+}
+inline void flow_v2::set_ports(uint32_t value) {
+  _internal_set_ports(value);
+  // @@protoc_insertion_point(field_set:flow_v2.ports)
+}
+
+// uint32 tcp_flags = 12;
+inline void flow_v2::clear_tcp_flags() {
+  _impl_.tcp_flags_ = 0u;
+}
+inline uint32_t flow_v2::_internal_tcp_flags() const {
+  return _impl_.tcp_flags_;
+}
+inline uint32_t flow_v2::tcp_flags() const {
+  // @@protoc_insertion_point(field_get:flow_v2.tcp_flags)
+  return _internal_tcp_flags();
+}
+inline void flow_v2::_internal_set_tcp_flags(uint32_t value) {
+  
+  _impl_.tcp_flags_ = value;
+}
+inline void flow_v2::set_tcp_flags(uint32_t value) {
+  _internal_set_tcp_flags(value);
+  // @@protoc_insertion_point(field_set:flow_v2.tcp_flags)
+}
+
+// uint32 end_reason = 13;
+inline void flow_v2::clear_end_reason() {
+  _impl_.end_reason_ = 0u;
+}
+inline uint32_t flow_v2::_internal_end_reason() const {
+  return _impl_.end_reason_;
+}
+inline uint32_t flow_v2::end_reason() const {
+  // @@protoc_insertion_point(field_get:flow_v2.end_reason)
+  return _internal_end_reason();
+}
+inline void flow_v2::_internal_set_end_reason(uint32_t value) {
+  
+  _impl_.end_reason_ = value;
+}
+inline void flow_v2::set_end_reason(uint32_t value) {
+  _internal_set_end_reason(value);
+  // @@protoc_insertion_point(field_set:flow_v2.end_reason)
+}
+
+// -------------------------------------------------------------------
+
+// flow_batch
+
+// repeated .flow_v2 flows = 1;
+inline int flow_batch::_internal_flows_size() const {
+  return _impl_.flows_.size();
+}
+inline int flow_batch::flows_size() const {
+  return _internal_flows_size();
+}
+inline void flow_batch::clear_flows() {
+  _impl_.flows_.Clear();
+}
+inline ::flow_v2* flow_batch::mutable_flows(int index) {
+  // @@protoc_insertion_point(field_mutable:flow_batch.flows)
+  return _impl_.flows_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::flow_v2 >*
+flow_batch::mutable_flows() {
+  // @@protoc_insertion_point(field_mutable_list:flow_batch.flows)
+  return &_impl_.flows_;
+}
+inline const ::flow_v2& flow_batch::_internal_flows(int index) const {
+  return _impl_.flows_.Get(index);
+}
+inline const ::flow_v2& flow_batch::flows(int index) const {
+  // @@protoc_insertion_point(field_get:flow_batch.flows)
+  return _internal_flows(index);
+}
+inline ::flow_v2* flow_batch::_internal_add_flows() {
+  return _impl_.flows_.Add();
+}
+inline ::flow_v2* flow_batch::add_flows() {
+  ::flow_v2* _add = _internal_add_flows();
+  // @@protoc_insertion_point(field_add:flow_batch.flows)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::flow_v2 >&
+flow_batch::flows() const {
+  // @@protoc_insertion_point(field_list:flow_batch.flows)
+  return _impl_.flows_;
+}
+
+// fixed64 sent = 2;
+inline void flow_batch::clear_sent() {
+  _impl_.sent_ = uint64_t{0u};
+}
+inline uint64_t flow_batch::_internal_sent() const {
+  return _impl_.sent_;
+}
+inline uint64_t flow_batch::sent() const {
+  // @@protoc_insertion_point(field_get:flow_batch.sent)
+  return _internal_sent();
+}
+inline void flow_batch::_internal_set_sent(uint64_t value) {
+  
+  _impl_.sent_ = value;
+}
+inline void flow_batch::set_sent(uint64_t value) {
+  _internal_set_sent(value);
+  // @@protoc_insertion_point(field_set:flow_batch.sent)
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+
+PROTOBUF_NAMESPACE_OPEN
+
+template <> struct is_proto_enum< ::transport> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::transport>() {
+  return ::transport_descriptor();
+}
+
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_pack_5fv2_2eproto
@@ -4,6 +4,25 @@
 #include <exception>
 #include <pcap.h>
 #include <functional>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <byteswap.h>
 
 void pc_sniffer::list_show(pcap_if_t *dev)
 {
@@ -22,6 +41,7 @@ pc_sniffer::pc_sniffer()
 
 pc_sniffer::~pc_sniffer()
 {
+    close_ring();
     if (interfaces != nullptr)
         pcap_freealldevs(interfaces); // free the list ponter form pcap_findalldevs
     if (handler != nullptr)
@@ -88,5 +108,656 @@ void pc_sniffer::init_file(char const *path)
 }
 
 void pc_sniffer::breakloop(){
-    pcap_breakloop(handler);
-}
\ No newline at end of file
+    ring_stop = true;
+    file_breaks++;
+    if (handler != nullptr)
+        pcap_breakloop(handler);
+}
+
+static std::runtime_error sys_error(const std::string &what)
+{
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+pc_sniffer::ring_worker::~ring_worker()
+{
+    if (th.joinable())
+        th.join();
+    if (map != nullptr)
+        munmap(map, map_len);
+    if (fd >= 0)
+        close(fd);
+}
+
+void pc_sniffer::close_ring()
+{
+    ring_stop = true;
+    workers.clear(); // ~ring_worker joins the thread and releases the ring
+}
+
+void pc_sniffer::init_ring(const char *device, const ring_options &opt, char const *filter_expression)
+{
+    if (opt.workers == 0 || opt.block_count == 0 || opt.frame_size == 0 || opt.block_size % opt.frame_size != 0 || opt.block_size % getpagesize() != 0)
+    {
+        throw std::invalid_argument("invalid ring_options");
+    }
+
+    close_ring();
+    ring_stop = false;
+
+    unsigned int ifindex = if_nametoindex(device);
+    if (ifindex == 0)
+    {
+        throw sys_error(std::string("unknown interface ") + device);
+    }
+
+    // compile the filter once, the same program is attached to every worker socket
+    const char *ex = expr;
+    if (filter_expression != nullptr)
+        ex = filter_expression;
+
+    pcap_t *dead = pcap_open_dead(DLT_EN10MB, opt.frame_size);
+    bpf_program prog;
+    if (pcap_compile(dead, &prog, ex, 1, PCAP_NETMASK_UNKNOWN) < 0)
+    {
+        std::string err = pcap_geterr(dead);
+        pcap_close(dead);
+        throw std::runtime_error(err);
+    }
+    pcap_close(dead);
+
+    // same group id for all workers of this sniffer -> the kernel balances between them
+    // fanout_group 0 : the first worker asks the kernel for an unused id (>= 4.11), the others join it,
+    // a group derived from the pid would be shared by every sniffer of the process
+    uint32_t fanout_arg = opt.fanout_group != 0 ? opt.fanout_group | (static_cast<uint32_t>(opt.fanout) << 16)
+                                                : static_cast<uint32_t>(opt.fanout | PACKET_FANOUT_FLAG_UNIQUEID) << 16;
+
+    try
+    {
+        for (uint32_t i = 0; i < opt.workers; i++)
+        {
+            auto w = std::make_unique<ring_worker>();
+            w->id = i;
+
+            // protocol 0 : nothing is received until bind, which happens after the ring and the filter are set up
+            if ((w->fd = socket(AF_PACKET, SOCK_RAW, 0)) < 0)
+                throw sys_error("socket(AF_PACKET)");
+
+            ifreq ifr;
+            std::memset(&ifr, 0, sizeof(ifr));
+            std::strncpy(ifr.ifr_name, device, IFNAMSIZ - 1);
+            if (ioctl(w->fd, SIOCGIFFLAGS, &ifr) < 0)
+                throw sys_error("SIOCGIFFLAGS");
+            w->skip_outgoing = ifr.ifr_flags & IFF_LOOPBACK;
+
+            int ver = TPACKET_V3;
+            if (setsockopt(w->fd, SOL_PACKET, PACKET_VERSION, &ver, sizeof(ver)) < 0)
+                throw sys_error("PACKET_VERSION");
+
+            tpacket_req3 req;
+            std::memset(&req, 0, sizeof(req));
+            req.tp_block_size = opt.block_size;
+            req.tp_block_nr = opt.block_count;
+            req.tp_frame_size = opt.frame_size;
+            req.tp_frame_nr = (opt.block_size / opt.frame_size) * opt.block_count;
+            req.tp_retire_blk_tov = opt.block_timeout_ms;
+            req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+            if (setsockopt(w->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+                throw sys_error("PACKET_RX_RING");
+
+            w->map_len = static_cast<size_t>(opt.block_size) * opt.block_count;
+            void *m = mmap(nullptr, w->map_len, PROT_READ | PROT_WRITE, MAP_SHARED, w->fd, 0);
+            if (m == MAP_FAILED)
+                throw sys_error("mmap(PACKET_RX_RING)");
+            w->map = static_cast<u_char *>(m);
+
+            w->blocks.resize(opt.block_count);
+            for (uint32_t b = 0; b < opt.block_count; b++)
+            {
+                w->blocks[b].iov_base = w->map + static_cast<size_t>(b) * opt.block_size;
+                w->blocks[b].iov_len = opt.block_size;
+            }
+            w->stats.block_count = opt.block_count;
+
+            // drop everything until the socket is in the fanout group, a bound socket that has not
+            // joined yet would see the packets of the other workers too
+            sock_filter drop_all = BPF_STMT(BPF_RET | BPF_K, 0);
+            sock_fprog fprog;
+            fprog.len = 1;
+            fprog.filter = &drop_all;
+            if (setsockopt(w->fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0)
+                throw sys_error("SO_ATTACH_FILTER");
+
+            sockaddr_ll ll;
+            std::memset(&ll, 0, sizeof(ll));
+            ll.sll_family = AF_PACKET;
+            ll.sll_protocol = htons(ETH_P_ALL);
+            ll.sll_ifindex = ifindex;
+            if (bind(w->fd, reinterpret_cast<sockaddr *>(&ll), sizeof(ll)) < 0)
+                throw sys_error("bind(AF_PACKET)");
+
+            if (setsockopt(w->fd, SOL_PACKET, PACKET_FANOUT, &fanout_arg, sizeof(fanout_arg)) < 0)
+                throw sys_error("PACKET_FANOUT");
+            if (fanout_arg & (PACKET_FANOUT_FLAG_UNIQUEID << 16))
+            {
+                uint32_t joined;
+                socklen_t joined_len = sizeof(joined);
+                if (getsockopt(w->fd, SOL_PACKET, PACKET_FANOUT, &joined, &joined_len) < 0)
+                    throw sys_error("PACKET_FANOUT");
+                fanout_arg = (joined & 0xffff) | (static_cast<uint32_t>(opt.fanout) << 16);
+            }
+
+            fprog.len = prog.bf_len;
+            fprog.filter = reinterpret_cast<sock_filter *>(prog.bf_insns);
+            if (setsockopt(w->fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0)
+                throw sys_error("SO_ATTACH_FILTER");
+
+            workers.push_back(std::move(w));
+        }
+    }
+    catch (...)
+    {
+        pcap_freecode(&prog);
+        close_ring();
+        throw;
+    }
+
+    pcap_freecode(&prog);
+}
+
+void pc_sniffer::set_worker_handler(uint32_t worker, pc_handler h, u_char *user)
+{
+    if (worker >= handlers.size())
+        handlers.resize(worker + 1);
+    handlers[worker].h = std::move(h);
+    handlers[worker].user = user;
+}
+
+pc_sniffer::worker_handler pc_sniffer::get_handler(uint32_t worker) const
+{
+    if (worker < handlers.size() && handlers[worker].h)
+        return handlers[worker];
+    return {h_func, nullptr};
+}
+
+// walk the blocks owned by user space, return each one to the kernel after the handler
+void pc_sniffer::ring_loop(ring_worker &w)
+{
+    pollfd pfd;
+    pfd.fd = w.fd;
+    pfd.events = POLLIN | POLLERR;
+    pfd.revents = 0;
+    auto last_idle = std::chrono::steady_clock::now();
+
+    while (!ring_stop)
+    {
+        auto *block = static_cast<tpacket_block_desc *>(w.blocks[w.current_block].iov_base);
+
+        // acquire : the packets of the block are read only after the kernel handed it over
+        if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (idle && now - last_idle >= std::chrono::milliseconds(to_ms))
+            {
+                idle(w.id);
+                last_idle = now;
+            }
+            poll(&pfd, 1, to_ms); // wake up at least every to_ms to check ring_stop
+            continue;
+        }
+
+        uint32_t num_pkts = block->hdr.bh1.num_pkts;
+        auto *ppd = reinterpret_cast<tpacket3_hdr *>(reinterpret_cast<u_char *>(block) + block->hdr.bh1.offset_to_first_pkt);
+        for (uint32_t i = 0; i < num_pkts; i++)
+        {
+            // sockaddr_ll follows the aligned header
+            auto *ll = reinterpret_cast<const sockaddr_ll *>(reinterpret_cast<u_char *>(ppd) + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+            if (!w.skip_outgoing || ll->sll_pkttype != PACKET_OUTGOING)
+                w.h(w.user, ppd->tp_snaplen, ppd->tp_len, ppd->tp_sec, ppd->tp_nsec / 1000, reinterpret_cast<u_char *>(ppd) + ppd->tp_mac);
+            ppd = reinterpret_cast<tpacket3_hdr *>(reinterpret_cast<u_char *>(ppd) + ppd->tp_next_offset);
+        }
+
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        w.current_block = (w.current_block + 1) % w.blocks.size();
+    }
+}
+
+void pc_sniffer::scan_ring()
+{
+    if (workers.empty())
+        throw std::logic_error("init_ring was not called");
+
+    // ring_stop is reset by init_ring and here once the workers ended, never at entry :
+    // a breakloop issued before the workers started must stop them
+    for (uint32_t i = 0; i < workers.size(); i++)
+    {
+        worker_handler wh = get_handler(i);
+        workers[i]->h = std::move(wh.h);
+        workers[i]->user = wh.user;
+    }
+
+    for (auto &w : workers)
+    {
+        ring_worker *wp = w.get();
+        wp->th = std::thread([this, wp]()
+                             { ring_loop(*wp); });
+    }
+    for (auto &w : workers)
+    {
+        w->th.join();
+    }
+    ring_stop = false;
+}
+
+ring_stats pc_sniffer::get_ring_stats(uint32_t worker)
+{
+    if (worker >= workers.size())
+        throw std::out_of_range("ring worker index");
+    ring_worker &w = *workers[worker];
+
+    tpacket_stats_v3 st;
+    socklen_t st_len = sizeof(st);
+    if (getsockopt(w.fd, SOL_PACKET, PACKET_STATISTICS, &st, &st_len) < 0)
+        throw sys_error("PACKET_STATISTICS");
+
+    // tp_packets also counts the dropped packets
+    w.stats.packets += st.tp_packets;
+    w.stats.drops += st.tp_drops;
+    w.stats.freeze_q_cnt += st.tp_freeze_q_cnt;
+
+    uint32_t in_use = 0;
+    for (const iovec &b : w.blocks)
+    {
+        auto *block = static_cast<tpacket_block_desc *>(b.iov_base);
+        if (__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)
+            in_use++;
+    }
+    w.stats.blocks_in_use = in_use;
+
+    return w.stats;
+}
+
+// ---- parallel offline reading (init_file_parallel)
+
+namespace
+{
+    // read-only mapping of the whole capture file
+    struct mapped_file
+    {
+        int fd = -1;
+        const u_char *p = nullptr;
+        size_t len = 0;
+
+        explicit mapped_file(char const *path)
+        {
+            if ((fd = open(path, O_RDONLY)) < 0)
+                throw sys_error(std::string("open ") + path);
+            struct stat sb;
+            if (fstat(fd, &sb) < 0)
+                throw sys_error("fstat");
+            len = sb.st_size;
+            if (len == 0)
+                throw std::runtime_error(std::string("empty file ") + path);
+            void *m = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m == MAP_FAILED)
+                throw sys_error("mmap");
+            p = static_cast<const u_char *>(m);
+        }
+
+        ~mapped_file()
+        {
+            if (p != nullptr)
+                munmap(const_cast<u_char *>(p), len);
+            if (fd >= 0)
+                close(fd);
+        }
+    };
+
+    enum class file_format
+    {
+        PCAP,
+        PCAPNG
+    };
+
+    struct capture_file
+    {
+        file_format format;
+        bool swapped = false;
+        uint64_t pcap_res = 1000000; // classic pcap : ticks per second (usec / nsec magic)
+
+        uint32_t r32(const u_char *p) const
+        {
+            uint32_t v;
+            std::memcpy(&v, p, 4);
+            return swapped ? bswap_32(v) : v;
+        }
+        uint16_t r16(const u_char *p) const
+        {
+            uint16_t v;
+            std::memcpy(&v, p, 2);
+            return swapped ? bswap_16(v) : v;
+        }
+    };
+
+    // records [begin, end) of the file, pcapng interfaces (ticks per second) valid at begin
+    struct file_chunk
+    {
+        size_t begin, end;
+        std::vector<uint64_t> if_res;
+    };
+
+    struct file_record
+    {
+        const u_char *data;
+        uint32_t cap, len;
+        uint64_t ts_us;
+    };
+
+    constexpr uint32_t PCAPNG_SHB = 0x0A0D0D0A, PCAPNG_IDB = 1, PCAPNG_PB = 2, PCAPNG_SPB = 3, PCAPNG_EPB = 6;
+
+    // if_tsresol option of an interface description block, default 10^-6
+    uint64_t idb_resolution(const capture_file &cf, const u_char *blk, uint32_t blen)
+    {
+        uint64_t res = 1000000;
+        size_t off = 16; // type, len, linktype + reserved, snaplen
+        while (off + 4 <= blen - 4)
+        {
+            uint16_t code = cf.r16(blk + off), olen = cf.r16(blk + off + 2);
+            if (code == 0)
+                break;
+            if (code == 9 && olen >= 1 && off + 5 <= blen - 4)
+            {
+                uint8_t v = blk[off + 4];
+                res = 1;
+                for (int i = 0; i < (v & 0x7f); i++)
+                    res *= (v & 0x80) ? 2 : 10;
+            }
+            off += 4 + ((olen + 3) & ~3u);
+        }
+        return res;
+    }
+
+    /*
+        one record at off : fills rec if the block/record is a packet, returns the offset of the next one
+        (0 -> end of data / truncated), if_res is updated on pcapng SHB/IDB
+    */
+    size_t next_record(const capture_file &cf, const u_char *p, size_t len, size_t off, std::vector<uint64_t> &if_res, file_record *rec, bool &is_packet)
+    {
+        is_packet = false;
+        if (cf.format == file_format::PCAP)
+        {
+            if (off + 16 > len)
+                return 0;
+            uint32_t incl = cf.r32(p + off + 8);
+            if (off + 16 + incl > len)
+                return 0;
+            if (rec != nullptr)
+            {
+                uint64_t sec = cf.r32(p + off), frac = cf.r32(p + off + 4);
+                rec->ts_us = sec * 1000000 + frac * 1000000 / cf.pcap_res;
+                rec->cap = incl;
+                rec->len = cf.r32(p + off + 12);
+                rec->data = p + off + 16;
+            }
+            is_packet = true;
+            return off + 16 + incl;
+        }
+
+        if (off + 12 > len)
+            return 0;
+        uint32_t type = cf.r32(p + off), blen = cf.r32(p + off + 4);
+        if (blen < 12 || blen % 4 != 0 || off + blen > len)
+            return 0;
+        const u_char *b = p + off;
+
+        switch (type)
+        {
+        case PCAPNG_SHB:
+            if_res.clear();
+            break;
+
+        case PCAPNG_IDB:
+            if (blen >= 20)
+                if_res.push_back(idb_resolution(cf, b, blen));
+            break;
+
+        case PCAPNG_EPB:
+        case PCAPNG_PB:
+        {
+            if (blen < 32)
+                return 0;
+            uint32_t iface = type == PCAPNG_EPB ? cf.r32(b + 8) : cf.r16(b + 8);
+            uint32_t cap = cf.r32(b + 20);
+            if (28 + static_cast<size_t>(cap) > blen - 4)
+                return 0;
+            if (rec != nullptr)
+            {
+                uint64_t res = iface < if_res.size() ? if_res[iface] : 1000000;
+                uint64_t ts = (uint64_t(cf.r32(b + 12)) << 32) | cf.r32(b + 16);
+                rec->ts_us = ts / res * 1000000 + (ts % res) * 1000000 / res;
+                rec->cap = cap;
+                rec->len = cf.r32(b + 24);
+                rec->data = b + 28;
+            }
+            is_packet = true;
+        }
+        break;
+
+        case PCAPNG_SPB:
+        {
+            if (blen < 16)
+                return 0;
+            if (rec != nullptr)
+            {
+                uint32_t orig = cf.r32(b + 8);
+                rec->len = orig;
+                rec->cap = std::min<uint32_t>(orig, blen - 16);
+                rec->ts_us = 0; // no timestamp in a simple packet block
+                rec->data = b + 12;
+            }
+            is_packet = true;
+        }
+        break;
+
+        default:
+            break;
+        }
+        return off + blen;
+    }
+
+    capture_file detect_format(const mapped_file &f)
+    {
+        capture_file cf;
+        if (f.len < 24)
+            throw std::runtime_error("file is too short for a capture header");
+
+        uint32_t magic;
+        std::memcpy(&magic, f.p, 4);
+        switch (magic)
+        {
+        case 0xa1b2c3d4: cf.format = file_format::PCAP; break;
+        case 0xd4c3b2a1: cf.format = file_format::PCAP; cf.swapped = true; break;
+        case 0xa1b23c4d: cf.format = file_format::PCAP; cf.pcap_res = 1000000000; break;
+        case 0x4d3cb2a1: cf.format = file_format::PCAP; cf.pcap_res = 1000000000; cf.swapped = true; break;
+        case PCAPNG_SHB:
+        {
+            cf.format = file_format::PCAPNG;
+            uint32_t bom;
+            std::memcpy(&bom, f.p + 8, 4);
+            if (bom == 0x4D3C2B1A)
+                cf.swapped = true;
+            else if (bom != 0x1A2B3C4D)
+                throw std::runtime_error("bad pcapng byte-order magic");
+        }
+        break;
+        default:
+            throw std::runtime_error("unknown capture file format");
+        }
+        return cf;
+    }
+}
+
+file_stats pc_sniffer::init_file_parallel(char const *path, const file_options &opt)
+{
+    using clock = std::chrono::steady_clock;
+    const auto t_start = clock::now();
+
+    if (opt.chunk_packets == 0 || (opt.replay == file_options::REPLAY_SCALED && opt.speed <= 0))
+        throw std::invalid_argument("invalid file_options");
+
+    // only a breakloop issued during this call stops it, one from before (pcap_loop, scan_ring) is not seen
+    const uint64_t breaks = file_breaks.load();
+    std::atomic<bool> stop{false};
+    auto stopped = [&]()
+    { return stop.load(std::memory_order_relaxed) || file_breaks.load(std::memory_order_relaxed) != breaks; };
+
+    mapped_file f(path);
+    capture_file cf = detect_format(f);
+    madvise(const_cast<u_char *>(f.p), f.len, MADV_WILLNEED);
+
+    // first pass : only the record headers are touched
+    std::vector<file_chunk> chunks;
+    std::vector<uint64_t> if_res;
+    uint64_t first_ts = 0;
+    bool have_first = false;
+    {
+        size_t off = cf.format == file_format::PCAP ? 24 : 0;
+        uint32_t in_chunk = 0;
+        bool is_packet, open = false;
+        while (off < f.len)
+        {
+            if (!open)
+            {
+                chunks.push_back({off, 0, if_res});
+                open = true;
+            }
+
+            file_record rec;
+            size_t next = next_record(cf, f.p, f.len, off, if_res, have_first ? nullptr : &rec, is_packet);
+            if (next == 0)
+                break;
+            if (is_packet)
+            {
+                if (!have_first)
+                {
+                    first_ts = rec.ts_us;
+                    have_first = true;
+                }
+                if (++in_chunk == opt.chunk_packets)
+                {
+                    in_chunk = 0;
+                    open = false;
+                }
+            }
+            chunks.back().end = next;
+            off = next;
+        }
+        if (!chunks.empty() && chunks.back().end == 0)
+            chunks.pop_back();
+    }
+
+    file_stats st;
+    st.chunks = chunks.size();
+    st.index_s = std::chrono::duration<double>(clock::now() - t_start).count();
+
+    uint32_t n_workers = opt.workers != 0 ? opt.workers : std::max(1u, std::thread::hardware_concurrency());
+    n_workers = std::min<size_t>(n_workers, std::max<size_t>(1, chunks.size()));
+
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<uint64_t> packets{0}, bytes{0};
+
+    std::mutex m;
+    std::condition_variable cv;
+    size_t merged = 0;
+    std::exception_ptr error;
+
+    const double speed = opt.replay == file_options::REPLAY_ORIGINAL ? 1.0 : opt.speed;
+    const clock::time_point wall_start = clock::now();
+
+    auto fail = [&](std::exception_ptr e)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (!error)
+            error = e;
+        stop = true;
+        cv.notify_all();
+    };
+
+    auto work = [&](uint32_t id)
+    {
+        worker_handler wh = get_handler(id);
+        uint64_t w_packets = 0, w_bytes = 0;
+        try
+        {
+            size_t k;
+            while (!stopped() && (k = next_chunk.fetch_add(1)) < chunks.size())
+            {
+                const file_chunk &c = chunks[k];
+                std::vector<uint64_t> res = c.if_res;
+                bool is_packet;
+                file_record rec;
+
+                for (size_t off = c.begin; off < c.end && !stopped();)
+                {
+                    off = next_record(cf, f.p, c.end, off, res, &rec, is_packet);
+                    if (off == 0)
+                        break;
+                    if (!is_packet)
+                        continue;
+
+                    if (opt.replay != file_options::REPLAY_MAX && rec.ts_us > first_ts)
+                        std::this_thread::sleep_until(wall_start + std::chrono::microseconds(static_cast<uint64_t>((rec.ts_us - first_ts) / speed)));
+
+                    wh.h(wh.user, rec.cap, rec.len, rec.ts_us / 1000000, rec.ts_us % 1000000, rec.data);
+                    w_packets++;
+                    w_bytes += rec.len;
+                }
+
+                if (opt.ordered)
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    // breakloop can not notify cv : recheck periodically
+                    while (merged != k && !stopped())
+                        cv.wait_for(lock, std::chrono::milliseconds(100));
+                    if (stopped())
+                        break;
+                    if (chunk_merge)
+                        chunk_merge(id, k);
+                    merged++;
+                    cv.notify_all();
+                }
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+        // every stop path wakes the workers waiting for a chunk this one will never merge
+        if (opt.ordered && stopped())
+        {
+            std::lock_guard<std::mutex> lock(m);
+            cv.notify_all();
+        }
+        packets += w_packets;
+        bytes += w_bytes;
+    };
+
+    std::vector<std::thread> pool;
+    for (uint32_t i = 1; i < n_workers; i++)
+    {
+        pool.emplace_back(work, i);
+    }
+    work(0);
+    for (auto &t : pool)
+    {
+        t.join();
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    st.packets = packets;
+    st.bytes = bytes;
+    st.total_s = std::chrono::duration<double>(clock::now() - t_start).count();
+    return st;
+}
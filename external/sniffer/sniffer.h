@@ -7,12 +7,78 @@
 */
 
 #include <functional>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cstdint>
 #include <pcap.h>
+#include <sys/uio.h>
+#include <linux/if_packet.h>
+
+// handler signature used by pcap_loop/init_file (h_func) and by every ring worker
+using pc_handler = std::function<void(u_char *user, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, const u_char *data)>;
+
+/*
+    options for pc_sniffer::init_ring (TPACKET_V3 mmap ring + PACKET_FANOUT)
+    block_size must be a multiple of the page size and of frame_size
+    every worker gets its own socket and its own ring (block_size * block_count bytes)
+*/
+struct ring_options
+{
+    enum fanout_mode
+    {
+        FANOUT_HASH = PACKET_FANOUT_HASH, // same flow -> same worker
+        FANOUT_CPU = PACKET_FANOUT_CPU,   // worker by the cpu the packet arrived on
+        FANOUT_RR = PACKET_FANOUT_LB      // round-robin
+    };
+
+    uint32_t block_size = 1 << 18, block_count = 16, frame_size = 2048; // 4 MiB per worker
+    uint32_t block_timeout_ms = 100; // kernel retires a not full block after this time
+    uint32_t workers = 1;
+    fanout_mode fanout = FANOUT_HASH;
+    uint16_t fanout_group = 0; // 0 -> unique id chosen by the kernel
+};
+
+// kernel counters are accumulated (PACKET_STATISTICS resets them on every read)
+struct ring_stats
+{
+    uint64_t packets = 0, drops = 0, freeze_q_cnt = 0;
+    uint32_t blocks_in_use = 0, block_count = 0; // ring occupancy at the moment of the call
+};
+
+/*
+    options for pc_sniffer::init_file_parallel (pcap / pcapng)
+    the file is mmap'd, a first pass finds the record boundaries, chunks of chunk_packets
+    records are decoded by a pool of workers
+*/
+struct file_options
+{
+    enum replay_mode
+    {
+        REPLAY_MAX,      // as fast as possible
+        REPLAY_ORIGINAL, // keep the gaps between packet timestamps
+        REPLAY_SCALED    // original timing speed times faster
+    };
+
+    uint32_t workers = 0; // 0 -> std::thread::hardware_concurrency()
+    uint32_t chunk_packets = 1 << 16;
+    // handlers run in parallel, chunk_merge is called for every chunk in file order (see set_chunk_merge)
+    bool ordered = false;
+    replay_mode replay = REPLAY_MAX;
+    double speed = 1.0; // for REPLAY_SCALED
+};
+
+struct file_stats
+{
+    uint64_t packets = 0, bytes = 0, chunks = 0;
+    double index_s = 0, total_s = 0; // first pass / whole run
+};
 
 class pc_sniffer
 {
 private:
-    static const int snaplen = 1518, to_ms = 1000;   // pcap_open_live max_pack_length dellay
+    static constexpr int snaplen = 1518, to_ms = 1000; // pcap_open_live max_pack_length dellay
     static constexpr char const *expr = "ip or ip6"; // pcap_compile
 
     char errbuf[PCAP_ERRBUF_SIZE];
@@ -23,6 +89,44 @@ private:
 
     void list_show(pcap_if_t *dev);
 
+    // one AF_PACKET socket + mmap'd TPACKET_V3 ring per worker thread
+    struct ring_worker
+    {
+        int fd = -1;
+        u_char *map = nullptr;
+        size_t map_len = 0;
+        std::vector<iovec> blocks;
+        size_t current_block = 0;
+        bool skip_outgoing = false; // loopback : every packet is seen as outgoing and again as incoming
+
+        uint32_t id = 0;
+        pc_handler h;
+        u_char *user = nullptr;
+        ring_stats stats;
+        std::thread th;
+
+        ~ring_worker();
+    };
+
+    std::vector<std::unique_ptr<ring_worker>> workers;
+    std::atomic<bool> ring_stop{false};     // set by breakloop, checked by the ring workers
+    std::atomic<uint64_t> file_breaks{0}; // breakloop count, init_file_parallel stops when it changes during the call
+
+    void ring_loop(ring_worker &w);
+    void close_ring();
+
+    // per-worker handlers for init_ring / init_file_parallel (empty -> h_func)
+    struct worker_handler
+    {
+        pc_handler h;
+        u_char *user = nullptr;
+    };
+    std::vector<worker_handler> handlers;
+    std::function<void(uint32_t worker, size_t chunk)> chunk_merge;
+    std::function<void(uint32_t worker)> idle;
+
+    worker_handler get_handler(uint32_t worker) const;
+
 public:
 
     pc_sniffer();
@@ -42,7 +146,42 @@ public:
 
     void breakloop();
 
+    /*
+        capture without pcap_loop : every worker reads its own TPACKET_V3 ring,
+        the kernel spreads the packets between workers with PACKET_FANOUT
+        by default every worker calls h_func, use set_worker_handler for per-worker handler
+        requires CAP_NET_RAW
+    */
+    void init_ring(const char *device, const ring_options &opt = ring_options(), char const *filter_expression = nullptr);
+
+    // handler for one worker of init_ring / init_file_parallel, user is passed as first argument of the handler
+    void set_worker_handler(uint32_t worker, pc_handler h, u_char *user = nullptr);
+
+    // start all workers and wait until breakloop()
+    void scan_ring();
+
+    // called from a ring worker thread when its ring is empty, at most every to_ms (ms)
+    // -> time based work of per-thread state (flow_table::expire) without packets
+    void set_idle_handler(std::function<void(uint32_t worker)> h) { idle = std::move(h); }
+
+    uint32_t ring_workers() const { return workers.size(); }
+
+    // kernel packets/drops for one worker + current ring occupancy
+    ring_stats get_ring_stats(uint32_t worker);
+
+    /*
+        offline mode for big captures : same as init_file, but the records are decoded in parallel
+        without ordered the handlers see the packets of different chunks at the same time
+        with ordered a worker finishing chunk k waits until chunk k-1 is merged,
+        calls chunk_merge(worker, k) and only then takes the next chunk
+        -> keep per-worker output in the handler and commit it in chunk_merge
+    */
+    file_stats init_file_parallel(char const *path, const file_options &opt = file_options());
+
+    // called in file order for every chunk in ordered mode (from the worker that decoded it)
+    void set_chunk_merge(std::function<void(uint32_t worker, size_t chunk)> merge) { chunk_merge = std::move(merge); }
+
     // satic handler function called in pcap_loop from pcap_handler
-    inline static std::function<void(u_char *user, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, const u_char *data)> h_func 
+    inline static pc_handler h_func 
         = [](u_char *user, uint32_t cap, uint32_t len, __time_t tv_sec, __suseconds_t tv_usec, const u_char *data){};
 };
@@ -1,10 +1,64 @@
 #include <iostream>
+#include <thread>
+#include <string>
+
 #include "../external/nats-client/nc.h"
+#include "../external/database/db.h"
+#include "../external/ingest/ingest.h"
 
 using namespace std;
 
+// clickhouse connection (native protocol)
+static constexpr char const *ch_user = "default", *ch_password = "", *ch_host = "localhost", *ch_database = "default";
+static constexpr int ch_port = 9000;
+
+void show_stats(const ingest_stats &st)
+{
+    cout << "messages " << st.messages << " records " << st.records << " bad " << st.bad << " dropped " << st.dropped
+         << " (" << st.messages_per_s << " msg/s, " << st.records_per_s << " rec/s)\n"
+         << "inserts " << st.writer.inserts << " rows " << st.writer.rows << " errors " << st.writer.errors
+         << " insert max " << st.writer.max_latency_us << "us\n"
+         << "publish -> worker avg " << st.recv_latency_avg_us << "us max " << st.recv_latency_max_us << "us, "
+         << "publish -> insert avg " << st.e2e_avg_us << "us max " << st.writer.max_e2e_us << "us" << endl;
+}
+
 int main(){
+    ingest_options opt;
+
+    short n;
+    cout << "ingest 1) packets (sniff.base) 2) flows (sniff.flows)\n-";
+    cin >> n;
+    if (n == 2){
+        opt.kind = ingest_options::FLOWS;
+        opt.subject = "sniff.flows";
+        opt.table = "flows";
+    }
+    opt.workers = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+
     nats_client rec;
-    
-    return 0;
-}
\ No newline at end of file
+    rec.nats_client_connect();
+
+    database db(ch_user, ch_password, ch_host, ch_port, ch_database);
+    ingest_server server(db, rec, opt);
+
+    cout << "subscribed to " << opt.subject << " (queue " << opt.queue << ", " << opt.workers << " workers) -> " << opt.table << '\n';
+    cout << "1) stop (drain)\n2) show stats\n";
+    while(1){
+        cout << '-';
+        if (!(cin >> n) || n == 1)
+            break;
+        if (n == 2)
+            show_stats(server.stats());
+    }
+
+    int ret = 0;
+    try{
+        server.drain();
+    }
+    catch (const exception &e){
+        cerr << "drain: " << e.what() << endl;
+        ret = 1;
+    }
+    show_stats(server.stats());
+    return ret;
+}
@@ -0,0 +1,140 @@
+/*
+    synthetic publisher for the ingest server : pack_v2 or flow_v2 records through nats_client async mode,
+    the same batches as the capture client sends, at a fixed rate or as fast as possible
+    nothing is dropped (FULL_BLOCK) : "sent" has to match the rows the server inserts
+
+    publisher [packs|flows] [records] [records/s, 0 -> max] [every n-th record IPv6, 0 -> none]
+*/
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "../external/nats-client/nc.h"
+#include "../external/protobuff/gen/pack_v2.pb.h"
+
+using namespace std;
+
+static uint64_t now_us()
+{
+    return chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// 2001:db8::n
+static string ip6(uint32_t n)
+{
+    string a(16, '\0');
+    a[0] = 0x20;
+    a[1] = 0x01;
+    a[2] = 0x0d;
+    a[3] = static_cast<char>(0xb8);
+    for (int i = 0; i < 4; i++)
+        a[12 + i] = static_cast<char>(n >> (24 - 8 * i));
+    return a;
+}
+
+static void fill(pack_v2 &p, uint64_t i, uint64_t ip6_every)
+{
+    p.Clear();
+    p.set_time(now_us());
+    p.set_framesize(64 + i % 1400);
+    string macs(12, '\0');
+    for (int b = 0; b < 6; b++)
+    {
+        macs[b] = static_cast<char>(0x02 + b);
+        macs[6 + b] = static_cast<char>(i >> (8 * b));
+    }
+    p.set_macs(macs);
+    if (ip6_every != 0 && i % ip6_every == 0)
+    {
+        p.set_ipv(6);
+        p.set_s_ip6(ip6(i));
+        p.set_d_ip6(ip6(1));
+    }
+    else
+    {
+        p.set_ipv(4);
+        p.set_s_ip4(0x0a000000 | (i & 0xffff));
+        p.set_d_ip4(0xc0a80001);
+    }
+    p.set_t_proto(i % 3 == 0 ? TR_UDP : TR_TCP);
+    p.set_ports((uint32_t(1024 + i % 60000) << 16) | (i % 3 == 0 ? 53 : 443));
+}
+
+static void fill(flow_v2 &f, uint64_t i, uint64_t ip6_every)
+{
+    f.Clear();
+    uint64_t now = now_us();
+    f.set_first(now - 1000 * (i % 60000));
+    f.set_last(now);
+    f.set_packets(1 + i % 1000);
+    f.set_bytes(f.packets() * (64 + i % 1400));
+    if (ip6_every != 0 && i % ip6_every == 0)
+    {
+        f.set_ipv(6);
+        f.set_s_ip6(ip6(i));
+        f.set_d_ip6(ip6(1));
+    }
+    else
+    {
+        f.set_ipv(4);
+        f.set_s_ip4(0x0a000000 | (i & 0xffff));
+        f.set_d_ip4(0xc0a80001);
+    }
+    f.set_t_proto(i % 3 == 0 ? TR_UDP : TR_TCP);
+    f.set_ports((uint32_t(1024 + i % 60000) << 16) | (i % 3 == 0 ? 53 : 443));
+    f.set_tcp_flags(i % 3 == 0 ? 0 : 0x18);
+    f.set_end_reason(i % 5);
+}
+
+template <class M>
+static void publish(nats_client &nc, uint64_t records, uint64_t rate, uint64_t ip6_every)
+{
+    M m;
+    string out;
+    auto start = chrono::steady_clock::now();
+    for (uint64_t i = 0; i < records; i++)
+    {
+        // rate : one check every 1000 records
+        if (rate != 0 && i % 1000 == 0)
+            this_thread::sleep_until(start + chrono::microseconds(i * 1000000 / rate));
+
+        fill(m, i, ip6_every);
+        m.SerializeToString(&out);
+        nc.publish_async(out.data(), out.size());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool flows = argc > 1 && strcmp(argv[1], "flows") == 0;
+    uint64_t records = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+    uint64_t rate = argc > 3 ? strtoull(argv[3], nullptr, 10) : 0;
+    uint64_t ip6_every = argc > 4 ? strtoull(argv[4], nullptr, 10) : 10;
+    const char *subject = flows ? "sniff.flows" : "sniff.base";
+
+    nats_client nc;
+    nc.nats_client_connect();
+
+    async_options opt;
+    opt.policy = async_options::FULL_BLOCK;
+    nc.start_async(subject, opt);
+
+    cout << "publishing " << records << (flows ? " flow_v2" : " pack_v2") << " records to " << subject
+         << (rate ? " at " + to_string(rate) + "/s" : string(" as fast as possible")) << endl;
+    auto start = chrono::steady_clock::now();
+    if (flows)
+        publish<flow_v2>(nc, records, rate, ip6_every);
+    else
+        publish<pack_v2>(nc, records, rate, ip6_every);
+    nc.stop_async();
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    async_stats st = nc.get_async_stats();
+    cout << "queued " << st.queued << " sent " << st.sent << " dropped " << st.dropped << " batches " << st.batches
+         << " errors " << st.publish_errors << " (" << st.sent / sec << " rec/s)" << endl;
+    return st.sent == records ? 0 : 1;
+}
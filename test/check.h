@@ -0,0 +1,27 @@
+#pragma once
+
+/*
+    minimal checks for the test executables : CHECK reports a failed condition and goes on,
+    main returns check_result() (exit code for ctest, 77 is kept for skipped tests)
+*/
+
+#include <iostream>
+
+inline int check_failed = 0;
+
+#define CHECK(c)                                                                  \
+    do                                                                            \
+    {                                                                             \
+        if (!(c))                                                                 \
+        {                                                                         \
+            std::cerr << __FILE__ << ':' << __LINE__ << " failed: " #c << std::endl; \
+            check_failed++;                                                       \
+        }                                                                         \
+    } while (0)
+
+inline int check_result()
+{
+    if (check_failed == 0)
+        std::cout << "ok" << std::endl;
+    return check_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+/*
+    netflow v9 / IPFIX export packet builder for the tests and bench_netflow
+    sets are appended one at a time, the IPFIX message length follows every set
+    values are written big endian with the length of their field
+*/
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <sys/types.h>
+
+struct export_field
+{
+    uint16_t type, len;      // len 0xffff -> variable length (IPFIX)
+    uint32_t enterprise = 0; // IPFIX only, != 0 -> enterprise bit + number
+};
+
+struct export_packet_builder
+{
+    int version;
+    std::vector<u_char> b;
+
+    void u8(unsigned v) { b.push_back(v); }
+    void u16(unsigned v) { u8(v >> 8); u8(v & 255); }
+    void u32(uint32_t v) { u16(v >> 16); u16(v & 0xffff); }
+    void be(uint64_t v, size_t len)
+    {
+        for (size_t i = len; i-- > 0;)
+            u8((v >> (8 * i)) & 255);
+    }
+    void set_len16(size_t at, size_t len) { b[at] = len >> 8; b[at + 1] = len & 255; }
+
+    // domain -> v9 source id / IPFIX observation domain
+    explicit export_packet_builder(int ver = 9, uint32_t domain = 1, uint32_t seq = 0) : version(ver)
+    {
+        u16(version);
+        u16(0); // v9 count / IPFIX length
+        if (version == 9)
+            u32(123456); // sysUptime
+        u32(1700000000);
+        u32(seq);
+        u32(domain);
+        end_message();
+    }
+
+    // header of a set, close it with close_set
+    size_t open_set(uint16_t id)
+    {
+        size_t s = b.size();
+        u16(id);
+        u16(0);
+        return s;
+    }
+
+    void close_set(size_t s, bool pad = true)
+    {
+        while (pad && (b.size() - s) % 4 != 0)
+            u8(0);
+        set_len16(s + 2, b.size() - s);
+        end_message();
+    }
+
+    // template set with one template
+    export_packet_builder &tmpl(uint16_t id, const std::vector<export_field> &fields)
+    {
+        size_t s = open_set(version == 9 ? 0 : 2);
+        u16(id);
+        u16(fields.size());
+        for (const export_field &f : fields)
+        {
+            u16(f.enterprise != 0 ? f.type | 0x8000 : f.type);
+            u16(f.len);
+            if (f.enterprise != 0)
+                u32(f.enterprise);
+        }
+        close_set(s, false);
+        return *this;
+    }
+
+    // data set of fixed length fields, one value per field and record
+    export_packet_builder &data(uint16_t id, const std::vector<export_field> &fields, const std::vector<std::vector<uint64_t>> &records)
+    {
+        size_t s = open_set(id);
+        for (const auto &r : records)
+        {
+            for (size_t f = 0; f < fields.size(); f++)
+                be(r[f], fields[f].len);
+        }
+        close_set(s);
+        return *this;
+    }
+
+    // IPFIX variable length value : 1 byte length, or 255 + 2 byte length from 255 bytes on
+    void varlen(const std::vector<u_char> &v)
+    {
+        if (v.size() < 255)
+            u8(v.size());
+        else
+        {
+            u8(255);
+            u16(v.size());
+        }
+        b.insert(b.end(), v.begin(), v.end());
+    }
+
+    void end_message()
+    {
+        if (version == 10)
+            set_len16(2, b.size());
+    }
+};
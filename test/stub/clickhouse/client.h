@@ -0,0 +1,169 @@
+#pragma once
+
+/*
+    the part of the clickhouse-cpp API used by database / table_writer, for tests that run without
+    the library and without a server : columns keep their values in memory,
+    the Client members are defined by the test (Insert sees the blocks table_writer sends)
+*/
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+namespace clickhouse
+{
+    class ValidationError : public std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
+
+    class Type
+    {
+        std::string name;
+
+    public:
+        explicit Type(std::string n) : name(std::move(n)) {}
+        std::string GetName() const { return name; }
+    };
+    using TypeRef = std::shared_ptr<Type>;
+
+    class Column;
+    using ColumnRef = std::shared_ptr<Column>;
+
+    class Column : public std::enable_shared_from_this<Column>
+    {
+        TypeRef type;
+
+    public:
+        explicit Column(TypeRef t) : type(std::move(t)) {}
+        virtual ~Column() = default;
+
+        TypeRef Type() const { return type; }
+        virtual size_t Size() const = 0;
+        virtual void Clear() = 0;
+        virtual ColumnRef Slice(size_t begin, size_t len) const = 0;
+
+        template <class T>
+        std::shared_ptr<T> As() { return std::dynamic_pointer_cast<T>(shared_from_this()); }
+    };
+
+    // values of type V, the derived column D only adds its Append overloads
+    template <class D, class V>
+    class ColumnValues : public Column
+    {
+    protected:
+        std::vector<V> data;
+
+    public:
+        explicit ColumnValues(std::string type) : Column(std::make_shared<clickhouse::Type>(std::move(type))) {}
+
+        const V &At(size_t i) const { return data.at(i); }
+        const V &operator[](size_t i) const { return data[i]; }
+        size_t Size() const override { return data.size(); }
+        void Clear() override { data.clear(); }
+        ColumnRef Slice(size_t begin, size_t len) const override
+        {
+            auto c = std::make_shared<D>();
+            c->data.assign(data.begin() + begin, data.begin() + std::min(data.size(), begin + len));
+            return c;
+        }
+    };
+
+    template <class T>
+    struct vector_type_name;
+    template <> struct vector_type_name<uint8_t> { static constexpr const char *name = "UInt8"; };
+    template <> struct vector_type_name<uint16_t> { static constexpr const char *name = "UInt16"; };
+    template <> struct vector_type_name<uint32_t> { static constexpr const char *name = "UInt32"; };
+    template <> struct vector_type_name<uint64_t> { static constexpr const char *name = "UInt64"; };
+
+    template <class T>
+    class ColumnVector : public ColumnValues<ColumnVector<T>, T>
+    {
+    public:
+        ColumnVector() : ColumnValues<ColumnVector<T>, T>(vector_type_name<T>::name) {}
+        void Append(const T &v) { this->data.push_back(v); }
+    };
+
+    using ColumnUInt8 = ColumnVector<uint8_t>;
+    using ColumnUInt16 = ColumnVector<uint16_t>;
+    using ColumnUInt32 = ColumnVector<uint32_t>;
+    using ColumnUInt64 = ColumnVector<uint64_t>;
+
+    // network byte order, as in clickhouse-cpp
+    class ColumnIPv4 : public ColumnValues<ColumnIPv4, in_addr_t>
+    {
+    public:
+        ColumnIPv4() : ColumnValues("IPv4") {}
+        void Append(in_addr_t v) { data.push_back(v); }
+        void Append(const std::string &s)
+        {
+            in_addr a;
+            if (inet_pton(AF_INET, s.c_str(), &a) != 1)
+                throw ValidationError("invalid IPv4 format, ip: " + s);
+            data.push_back(a.s_addr);
+        }
+    };
+
+    class ColumnIPv6 : public ColumnValues<ColumnIPv6, in6_addr>
+    {
+    public:
+        ColumnIPv6() : ColumnValues("IPv6") {}
+        void Append(const in6_addr &v) { data.push_back(v); }
+        void Append(std::string_view s)
+        {
+            in6_addr a;
+            if (inet_pton(AF_INET6, std::string(s).c_str(), &a) != 1)
+                throw ValidationError("invalid IPv6 format, ip: " + std::string(s));
+            data.push_back(a);
+        }
+    };
+
+    class ColumnString : public ColumnValues<ColumnString, std::string>
+    {
+    public:
+        ColumnString() : ColumnValues("String") {}
+        void Append(std::string_view s) { data.emplace_back(s); }
+    };
+
+    class Block
+    {
+        std::vector<std::pair<std::string, ColumnRef>> columns;
+
+    public:
+        void AppendColumn(const std::string &name, const ColumnRef &col) { columns.emplace_back(name, col); }
+        size_t GetColumnCount() const { return columns.size(); }
+        size_t GetRowCount() const { return columns.empty() ? 0 : columns[0].second->Size(); }
+        const std::string &GetColumnName(size_t i) const { return columns.at(i).first; }
+        ColumnRef operator[](size_t i) const { return columns.at(i).second; }
+    };
+
+    struct ClientOptions
+    {
+        std::string host = "localhost", default_database = "default", user = "default", password;
+        unsigned int port = 9000;
+
+        ClientOptions &SetHost(const std::string &v) { host = v; return *this; }
+        ClientOptions &SetPort(unsigned int v) { port = v; return *this; }
+        ClientOptions &SetDefaultDatabase(const std::string &v) { default_database = v; return *this; }
+        ClientOptions &SetUser(const std::string &v) { user = v; return *this; }
+        ClientOptions &SetPassword(const std::string &v) { password = v; return *this; }
+    };
+
+    // defined by the test
+    class Client
+    {
+    public:
+        explicit Client(const ClientOptions &opts);
+        ~Client();
+
+        void Execute(const std::string &query);
+        void Insert(const std::string &table_name, const Block &block);
+    };
+}
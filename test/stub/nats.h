@@ -0,0 +1,45 @@
+#pragma once
+
+/*
+    the part of the nats.c API used by nats_client, for tests that run without the library
+    and without a nats-server : the test defines the functions it needs
+*/
+
+#include <cstdint>
+
+typedef enum
+{
+    NATS_OK = 0,
+    NATS_ERR,
+    NATS_TIMEOUT
+} natsStatus;
+
+typedef struct __natsConnection natsConnection;
+typedef struct __natsSubscription natsSubscription;
+typedef struct __natsMsg natsMsg;
+
+typedef void (*natsMsgHandler)(natsConnection *nc, natsSubscription *sub, natsMsg *msg, void *closure);
+typedef void (*natsOnCompleteCB)(void *closure);
+
+#define NATS_DEFAULT_URL "nats://localhost:4222"
+
+natsStatus natsConnection_ConnectTo(natsConnection **nc, const char *urls);
+natsStatus natsConnection_Publish(natsConnection *nc, const char *subj, const void *data, int dataLen);
+natsStatus natsConnection_FlushTimeout(natsConnection *nc, int64_t timeout);
+natsStatus natsConnection_Subscribe(natsSubscription **sub, natsConnection *nc, const char *subject, natsMsgHandler cb, void *cbClosure);
+natsStatus natsConnection_QueueSubscribe(natsSubscription **sub, natsConnection *nc, const char *subject, const char *queueGroup, natsMsgHandler cb, void *cbClosure);
+void natsConnection_Close(natsConnection *nc);
+void natsConnection_Destroy(natsConnection *nc);
+
+natsStatus natsSubscription_Drain(natsSubscription *sub);
+natsStatus natsSubscription_WaitForDrainCompletion(natsSubscription *sub, int64_t timeout);
+natsStatus natsSubscription_GetDropped(natsSubscription *sub, int64_t *msgs);
+natsStatus natsSubscription_SetOnCompleteCB(natsSubscription *sub, natsOnCompleteCB cb, void *closure);
+natsStatus natsSubscription_Unsubscribe(natsSubscription *sub);
+void natsSubscription_Destroy(natsSubscription *sub);
+
+const char *natsMsg_GetData(const natsMsg *msg);
+int natsMsg_GetDataLength(const natsMsg *msg);
+void natsMsg_Destroy(natsMsg *msg);
+
+const char *natsStatus_GetText(natsStatus s);
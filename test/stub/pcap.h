@@ -0,0 +1,67 @@
+#pragma once
+
+/*
+    the part of the libpcap API used by pc_sniffer, for tests of the paths that do not need
+    the library (init_file_parallel reads the file itself) : the test defines the functions it needs
+*/
+
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+
+#define PCAP_ERRBUF_SIZE 256
+#define PCAP_NETMASK_UNKNOWN 0xffffffff
+#define DLT_EN10MB 1
+
+typedef unsigned int bpf_u_int32;
+typedef struct pcap pcap_t;
+
+struct bpf_insn
+{
+    u_short code;
+    u_char jt, jf;
+    bpf_u_int32 k;
+};
+
+struct bpf_program
+{
+    u_int bf_len;
+    struct bpf_insn *bf_insns;
+};
+
+struct pcap_pkthdr
+{
+    struct timeval ts;
+    bpf_u_int32 caplen, len;
+};
+
+struct pcap_addr
+{
+    struct pcap_addr *next;
+    struct sockaddr *addr, *netmask, *broadaddr, *dstaddr;
+};
+
+typedef struct pcap_if
+{
+    struct pcap_if *next;
+    char *name, *description;
+    struct pcap_addr *addresses;
+    bpf_u_int32 flags;
+} pcap_if_t;
+
+typedef void (*pcap_handler)(u_char *, const struct pcap_pkthdr *, const u_char *);
+
+int pcap_findalldevs(pcap_if_t **, char *);
+void pcap_freealldevs(pcap_if_t *);
+int pcap_lookupnet(const char *, bpf_u_int32 *, bpf_u_int32 *, char *);
+pcap_t *pcap_open_live(const char *, int, int, int, char *);
+pcap_t *pcap_open_offline(const char *, char *);
+pcap_t *pcap_open_dead(int, int);
+int pcap_compile(pcap_t *, struct bpf_program *, const char *, int, bpf_u_int32);
+int pcap_setfilter(pcap_t *, struct bpf_program *);
+void pcap_freecode(struct bpf_program *);
+int pcap_loop(pcap_t *, int, pcap_handler, u_char *);
+int pcap_next_ex(pcap_t *, struct pcap_pkthdr **, const u_char **);
+void pcap_breakloop(pcap_t *);
+char *pcap_geterr(pcap_t *);
+void pcap_close(pcap_t *);
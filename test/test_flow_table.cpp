@@ -0,0 +1,263 @@
+/*
+    flow_table : every added packet comes out in exactly one flow, whatever ended it
+    (idle, active, FIN/RST, pressure, flush), lookups still find the flows of a collision chain
+    after a backward-shift delete in the chain (also across the end of the array),
+    and flows are ended by the idle / active timeouts from add and from expire
+*/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <random>
+#include <cstring>
+#include <netinet/tcp.h>
+
+#include "../external/flow_table/flow_table.h"
+#include "check.h"
+
+using namespace std;
+
+static const uint64_t t0 = 1700000000ull * 1000000, ms = 1000, sec = 1000000;
+
+static decoded_pack packet(uint64_t time_us, uint32_t s_ip4, uint16_t s_port, t_proto proto = t_proto::UDP, uint8_t tcp_flags = 0, uint32_t size = 100)
+{
+    decoded_pack p;
+    memset(&p, 0, sizeof(p));
+    p.time_us = time_us;
+    p.frame_size = size;
+    p.ipv = 4;
+    p.s_ip4 = s_ip4;
+    p.d_ip4 = 0x0a000001;
+    p.proto = proto;
+    p.s_port = s_port;
+    p.d_port = 443;
+    p.tcp_flags = tcp_flags;
+    return p;
+}
+
+// source address and port of a flow
+using flow_id = tuple<uint32_t, uint16_t, uint8_t>;
+
+static flow_id id_of(const flow_key &k)
+{
+    uint32_t ip;
+    memcpy(&ip, k.s_ip, 4);
+    return {ip, k.s_port, k.proto};
+}
+
+// emitted flows summed per key and per reason
+struct collector
+{
+    map<flow_id, uint64_t> packets, bytes;
+    map<flow_id, int> flows;
+    uint64_t by_reason[5] = {};
+    vector<flow_record> records;
+
+    function<void(const flow_record &)> sink()
+    {
+        return [this](const flow_record &r)
+        {
+            flow_id id = id_of(r.key);
+            packets[id] += r.packets;
+            bytes[id] += r.bytes;
+            flows[id]++;
+            by_reason[r.reason]++;
+            records.push_back(r);
+        };
+    }
+};
+
+// random traffic on a small table : all end reasons happen, the sums per flow match what was added
+static void every_packet_accounted()
+{
+    collector c;
+    flow_table_options opt;
+    opt.capacity = 64;
+    opt.idle_timeout_us = 2 * sec;
+    opt.active_timeout_us = 10 * sec;
+    flow_table t(c.sink(), opt);
+
+    mt19937 rng(7);
+    map<flow_id, uint64_t> sent_packets, sent_bytes;
+    uint64_t now = t0;
+    for (int i = 0; i < 200000; i++)
+    {
+        // quiet periods : every flow goes idle
+        now += i % 25000 == 0 ? 3 * sec : rng() % (2 * ms);
+        // more flows than the table takes (pressure), then only a few busy flows (active timeout)
+        bool busy = i >= 100000 || rng() % 4 == 0;
+        uint32_t ip = busy ? 0xc0a80001 + rng() % 8 : 0xc0a90000 + rng() % 100;
+        uint16_t port = busy ? 1000 : 2000;
+        bool tcp = !busy && rng() % 2 == 0;
+        uint8_t flags = tcp && rng() % 50 == 0 ? (rng() % 2 ? TH_FIN : TH_RST) : 0;
+        uint32_t size = 60 + rng() % 1400;
+
+        t.add(packet(now, ip, port, tcp ? t_proto::TCP : t_proto::UDP, flags, size));
+        flow_id id{ip, port, uint8_t(tcp ? t_proto::TCP : t_proto::UDP)};
+        sent_packets[id]++;
+        sent_bytes[id] += size;
+    }
+    flow_table_stats before = t.stats();
+    t.flush();
+    flow_table_stats st = t.stats();
+
+    cout << "accounting : " << st.created << " flows, idle " << st.idle << " active " << st.active << " fin_rst " << st.fin_rst
+         << " pressure " << st.pressure << " flushed " << st.flushed << ", max probe " << st.max_probe << endl;
+    CHECK(before.size != 0 && st.size == 0);
+    CHECK(st.idle > 0 && st.active > 0 && st.fin_rst > 0 && st.pressure > 0 && st.flushed > 0);
+    CHECK(st.idle + st.active + st.fin_rst + st.pressure + st.flushed == st.created);
+    CHECK(c.records.size() == st.created);
+    CHECK(c.by_reason[flow_record::IDLE] == st.idle && c.by_reason[flow_record::ACTIVE] == st.active);
+    CHECK(c.by_reason[flow_record::FIN_RST] == st.fin_rst && c.by_reason[flow_record::PRESSURE] == st.pressure);
+    CHECK(c.by_reason[flow_record::FLUSH] == st.flushed);
+    CHECK(c.packets == sent_packets);
+    CHECK(c.bytes == sent_bytes);
+    CHECK(st.packets == 200000 && st.ignored == 0);
+}
+
+// same hash as flow_table::hash_key (FNV-1a over the zeroed key) to build collision chains
+static uint32_t home_of(const decoded_pack &p, size_t mask)
+{
+    flow_key k;
+    memset(&k, 0, sizeof(k));
+    memcpy(k.s_ip, &p.s_ip4, 4);
+    memcpy(k.d_ip, &p.d_ip4, 4);
+    k.s_port = p.s_port;
+    k.d_port = p.d_port;
+    k.proto = static_cast<uint8_t>(p.proto);
+    k.ipv = p.ipv;
+
+    uint32_t h = 2166136261u;
+    const uint8_t *b = reinterpret_cast<const uint8_t *>(&k);
+    for (size_t i = 0; i < sizeof(k); i++)
+        h = (h ^ b[i]) * 16777619u;
+    return (h == 0 ? 1 : h) & mask;
+}
+
+// first n TCP flows (source ports from 1) whose home slot is home
+static vector<uint16_t> ports_with_home(size_t home, size_t mask, size_t n, uint16_t &next)
+{
+    vector<uint16_t> ports;
+    for (; ports.size() < n; next++)
+    {
+        if (home_of(packet(0, 0x0a000002, next, t_proto::TCP), mask) == home)
+            ports.push_back(next);
+    }
+    return ports;
+}
+
+/*
+    chain at slot 5 : a b c (home 5) then d (home 6, displaced behind them)
+    chain at the end : e f (home 15) then g (home 0, wraps to slot 1)
+    FIN on b and e moves the rest of each chain back, every other flow is still found
+*/
+static void backward_shift_lookup()
+{
+    collector c;
+    flow_table_options opt;
+    opt.capacity = 16;
+    flow_table t(c.sink(), opt);
+    const size_t mask = 15;
+
+    uint16_t next = 1;
+    vector<uint16_t> home5 = ports_with_home(5, mask, 3, next), home6 = ports_with_home(6, mask, 1, next);
+    vector<uint16_t> home15 = ports_with_home(15, mask, 2, next), home0 = ports_with_home(0, mask, 1, next);
+    const vector<uint16_t> order = {home5[0], home5[1], home5[2], home6[0], home15[0], home15[1], home0[0]};
+    const uint16_t deleted[2] = {home5[1], home15[0]};
+
+    uint64_t now = t0;
+    for (uint16_t port : order)
+        t.add(packet(now += ms, 0x0a000002, port, t_proto::TCP));
+    CHECK(t.stats().created == 7 && t.stats().max_probe >= 2);
+
+    for (uint16_t port : deleted)
+        t.add(packet(now += ms, 0x0a000002, port, t_proto::TCP, TH_FIN));
+    CHECK(t.stats().fin_rst == 2 && t.stats().size == 5);
+
+    // every remaining flow is found (no new flow), twice to also go through the moved slots
+    for (int round = 0; round < 2; round++)
+    {
+        for (uint16_t port : order)
+        {
+            if (port != deleted[0] && port != deleted[1])
+                t.add(packet(now += ms, 0x0a000002, port, t_proto::TCP));
+        }
+    }
+    CHECK(t.stats().created == 7 && t.stats().size == 5);
+
+    t.flush();
+    for (uint16_t port : order)
+    {
+        flow_id id{0x0a000002, port, uint8_t(t_proto::TCP)};
+        bool was_deleted = port == deleted[0] || port == deleted[1];
+        CHECK(c.flows[id] == 1);
+        CHECK(c.packets[id] == (was_deleted ? 2u : 3u));
+    }
+    CHECK(t.stats().flushed == 5 && t.stats().size == 0);
+}
+
+// idle flows end on later packets of other flows or on expire, long flows are cut every active_timeout
+static void timeouts()
+{
+    collector c;
+    uint64_t now = t0, emitted_at = 0;
+    vector<uint64_t> emit_times;
+    auto sink = c.sink();
+    flow_table_options opt;
+    opt.capacity = 16;
+    opt.idle_timeout_us = 1 * sec;
+    opt.active_timeout_us = 5 * sec;
+    flow_table t([&](const flow_record &r)
+                 { emit_times.push_back(emitted_at); sink(r); }, opt);
+
+    // x : one packet, y : a packet every 100 ms for 12 s
+    emitted_at = now;
+    t.add(packet(now, 0x0a000010, 10));
+    for (int i = 0; i <= 120; i++)
+    {
+        emitted_at = now = t0 + i * 100 * ms;
+        t.add(packet(now, 0x0a000020, 20));
+    }
+
+    flow_id x{0x0a000010, 10, uint8_t(t_proto::UDP)}, y{0x0a000020, 20, uint8_t(t_proto::UDP)};
+    CHECK(c.flows[x] == 1 && c.packets[x] == 1);
+    vector<flow_record> ys;
+    for (size_t i = 0; i < c.records.size(); i++)
+    {
+        const flow_record &r = c.records[i];
+        if (id_of(r.key) == x)
+        {
+            CHECK(r.reason == flow_record::IDLE);
+            // the sweep reaches the slot within capacity / sweep_per_packet packets
+            CHECK(emit_times[i] >= t0 + opt.idle_timeout_us && emit_times[i] <= t0 + opt.idle_timeout_us + 500 * ms);
+        }
+        else
+        {
+            CHECK(r.reason == flow_record::ACTIVE);
+            CHECK(emit_times[i] - r.first_us >= opt.active_timeout_us && emit_times[i] - r.first_us <= opt.active_timeout_us + 500 * ms);
+            ys.push_back(r);
+        }
+    }
+    CHECK(ys.size() == 2);
+
+    // the rest of y ends on expire only once it has been idle for idle_timeout
+    size_t emitted = c.records.size();
+    t.expire(now + opt.idle_timeout_us - 1);
+    CHECK(c.records.size() == emitted);
+    emitted_at = now + opt.idle_timeout_us;
+    t.expire(now + opt.idle_timeout_us);
+    CHECK(c.records.size() == emitted + 1);
+    CHECK(!c.records.empty() && c.records.back().reason == flow_record::IDLE && c.records.back().last_us == now);
+    CHECK(c.packets[y] == 121 && c.flows[y] == 3);
+    CHECK(t.stats().size == 0 && t.stats().idle == 2 && t.stats().active == 2);
+}
+
+int main()
+{
+    every_packet_accounted();
+    backward_shift_lookup();
+    timeouts();
+
+    return check_result();
+}
@@ -0,0 +1,494 @@
+/*
+    ingest_server against stub/nats.h and stub/clickhouse (no nats-server, no clickhouse) :
+    the stubbed nats functions below are a small in-process server with queue groups
+    (every message goes to one member of each group, every subscription has its own delivery thread),
+    records are published by nats_client async mode as the capture client / server/publisher do
+
+    - one message per queue group : two servers of one group share the subject, another group gets a copy
+    - after drain() every published record is an inserted row (packs and flows)
+    - a drain that times out and a failed subscribe close the queue subscriptions
+      before the workers (and their writers) are freed
+*/
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <algorithm>
+
+#include "../external/ingest/ingest.h"
+#include "../external/protobuff/gen/pack_v2.pb.h"
+#include "check.h"
+
+using namespace std;
+using namespace clickhouse;
+
+// ---- stubbed nats.c : in-process server
+
+struct __natsConnection
+{
+};
+
+struct __natsMsg
+{
+    string data;
+};
+
+struct __natsSubscription
+{
+    string subject, queue;
+    natsMsgHandler cb;
+    void *closure;
+    natsOnCompleteCB on_complete = nullptr;
+    void *complete_closure = nullptr;
+
+    mutex m;
+    condition_variable cv;
+    deque<string> msgs;
+    bool draining = false, closed = false;
+    atomic<bool> ended{false};
+    atomic<uint64_t> delivered{0};
+    thread th;
+};
+
+static mutex srv_m;
+static vector<natsSubscription *> srv_subs; // not destroyed yet
+static map<string, size_t> srv_next;         // subject + queue -> next member
+static atomic<bool> drain_stuck{false};      // drained subscriptions never complete (WaitForDrainCompletion times out)
+static atomic<int> subscribe_calls{0}, fail_subscribe_at{0};
+
+static void deliver(natsSubscription *s)
+{
+    unique_lock<mutex> lock(s->m);
+    while (1)
+    {
+        s->cv.wait(lock, [s]()
+                   { return !s->msgs.empty() || s->closed || (s->draining && !drain_stuck); });
+        if (s->closed || (s->msgs.empty() && s->draining && !drain_stuck))
+            break;
+        natsMsg *msg = new natsMsg{std::move(s->msgs.front())};
+        s->msgs.pop_front();
+        lock.unlock();
+        s->cb(nullptr, s, msg, s->closure);
+        s->delivered++;
+        lock.lock();
+    }
+    natsOnCompleteCB cb = s->on_complete;
+    void *closure = s->complete_closure;
+    lock.unlock();
+    if (cb != nullptr)
+        cb(closure);
+    lock.lock();
+    s->ended = true;
+    s->cv.notify_all();
+}
+
+natsStatus natsConnection_ConnectTo(natsConnection **nc, const char *)
+{
+    *nc = new natsConnection;
+    return NATS_OK;
+}
+
+natsStatus natsConnection_Publish(natsConnection *, const char *subject, const void *data, int len)
+{
+    lock_guard<mutex> lock(srv_m);
+    map<string, vector<natsSubscription *>> groups;
+    for (natsSubscription *s : srv_subs)
+    {
+        lock_guard<mutex> sl(s->m);
+        if (s->subject == subject && !s->draining && !s->closed)
+            groups[s->queue].push_back(s);
+    }
+    for (auto &[queue, members] : groups)
+    {
+        natsSubscription *s = members[srv_next[subject + (' ' + queue)]++ % members.size()];
+        lock_guard<mutex> sl(s->m);
+        s->msgs.emplace_back(static_cast<const char *>(data), len);
+        s->cv.notify_all();
+    }
+    return NATS_OK;
+}
+
+natsStatus natsConnection_QueueSubscribe(natsSubscription **sub, natsConnection *, const char *subject, const char *queue, natsMsgHandler cb, void *closure)
+{
+    if (++subscribe_calls == fail_subscribe_at)
+        return NATS_ERR;
+    natsSubscription *s = new natsSubscription;
+    s->subject = subject;
+    s->queue = queue;
+    s->cb = cb;
+    s->closure = closure;
+    s->th = thread(deliver, s);
+    lock_guard<mutex> lock(srv_m);
+    srv_subs.push_back(s);
+    *sub = s;
+    return NATS_OK;
+}
+
+natsStatus natsSubscription_SetOnCompleteCB(natsSubscription *s, natsOnCompleteCB cb, void *closure)
+{
+    lock_guard<mutex> lock(s->m);
+    s->on_complete = cb;
+    s->complete_closure = closure;
+    return NATS_OK;
+}
+
+natsStatus natsSubscription_Drain(natsSubscription *s)
+{
+    lock_guard<mutex> lock(s->m);
+    s->draining = true;
+    s->cv.notify_all();
+    return NATS_OK;
+}
+
+natsStatus natsSubscription_WaitForDrainCompletion(natsSubscription *s, int64_t timeout)
+{
+    unique_lock<mutex> lock(s->m);
+    return s->cv.wait_for(lock, chrono::milliseconds(timeout), [s]()
+                          { return s->ended.load(); })
+               ? NATS_OK
+               : NATS_TIMEOUT;
+}
+
+// messages not delivered yet are lost
+natsStatus natsSubscription_Unsubscribe(natsSubscription *s)
+{
+    lock_guard<mutex> lock(s->m);
+    if (s->closed || s->ended)
+        return NATS_ERR;
+    s->closed = true;
+    s->msgs.clear();
+    s->cv.notify_all();
+    return NATS_OK;
+}
+
+void natsSubscription_Destroy(natsSubscription *s)
+{
+    if (s == nullptr)
+        return;
+    natsSubscription_Unsubscribe(s);
+    s->th.join();
+    {
+        lock_guard<mutex> lock(srv_m);
+        srv_subs.erase(find(srv_subs.begin(), srv_subs.end(), s));
+    }
+    delete s;
+}
+
+natsStatus natsSubscription_GetDropped(natsSubscription *, int64_t *msgs)
+{
+    *msgs = 0;
+    return NATS_OK;
+}
+
+natsStatus natsConnection_FlushTimeout(natsConnection *, int64_t) { return NATS_OK; }
+natsStatus natsConnection_Subscribe(natsSubscription **, natsConnection *, const char *, natsMsgHandler, void *) { return NATS_ERR; }
+void natsConnection_Close(natsConnection *) {}
+void natsConnection_Destroy(natsConnection *nc) { delete nc; }
+const char *natsMsg_GetData(const natsMsg *msg) { return msg->data.data(); }
+int natsMsg_GetDataLength(const natsMsg *msg) { return msg->data.size(); }
+void natsMsg_Destroy(natsMsg *msg) { delete msg; }
+const char *natsStatus_GetText(natsStatus s) { return s == NATS_TIMEOUT ? "timeout" : "error"; }
+
+// subscriptions whose delivery thread can still call a handler
+static size_t live_subscriptions()
+{
+    lock_guard<mutex> lock(srv_m);
+    return count_if(srv_subs.begin(), srv_subs.end(), [](natsSubscription *s)
+                    { return !s->ended; });
+}
+
+// ---- stubbed clickhouse Client : rows and column sums per table
+
+struct table_rows
+{
+    uint64_t rows = 0, col0 = 0, col2 = 0, ipv6 = 0;
+};
+
+static mutex tables_m;
+static map<string, table_rows> tables;
+static atomic<int> writers_freed{0}, freed_while_delivering{0};
+
+Client::Client(const ClientOptions &) {}
+
+// the workers own the writers : a writer freed while a subscription still delivers is a worker freed too early
+Client::~Client()
+{
+    writers_freed++;
+    if (live_subscriptions() != 0)
+        freed_while_delivering++;
+}
+
+void Client::Execute(const string &) {}
+
+void Client::Insert(const string &table, const Block &block)
+{
+    lock_guard<mutex> lock(tables_m);
+    table_rows &t = tables[table];
+    auto c0 = block[0]->As<ColumnUInt64>();
+    auto c2 = block[2]->As<ColumnUInt64>();
+    auto ipv = block[4]->As<ColumnUInt8>();
+    for (size_t i = 0; i < block.GetRowCount(); i++)
+    {
+        t.col0 += c0->At(i);
+        t.col2 += c2->At(i);
+        t.ipv6 += ipv->At(i) == 6;
+    }
+    t.rows += block.GetRowCount();
+}
+
+static table_rows rows_of(const string &table)
+{
+    lock_guard<mutex> lock(tables_m);
+    return tables[table];
+}
+
+// ---- tests
+
+// what was published, same sums as table_rows
+struct published
+{
+    uint64_t records = 0, batches = 0, col0 = 0, col2 = 0, ipv6 = 0;
+};
+
+static published publish_packs(const char *subject, uint64_t n)
+{
+    nats_client nc;
+    nc.nats_client_connect();
+    async_options opt;
+    opt.policy = async_options::FULL_BLOCK;
+    opt.batch_bytes = 2048; // many batches -> every member gets some
+    opt.batch_ms = 1;
+    nc.start_async(subject, opt);
+
+    published pub;
+    pack_v2 p;
+    string out;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        p.Clear();
+        p.set_time(1700000000000000 + i);
+        p.set_framesize(64 + i % 1400);
+        p.set_macs(string(12, char(i)));
+        p.set_ipv(i % 10 == 0 ? 6 : 4);
+        if (p.ipv() == 6)
+            p.set_s_ip6(string(16, char(i)));
+        else
+            p.set_s_ip4(0x0a000000 + i);
+        p.set_t_proto(TR_TCP);
+        p.set_ports((1024u << 16) | 443);
+        p.SerializeToString(&out);
+        CHECK(nc.publish_async(out.data(), out.size()));
+
+        pub.col0 += p.time();
+        pub.col2 += uint64_t(uint8_t(i)) * 0x010101010101ull; // s_mac : 6 bytes equal to i
+        pub.ipv6 += p.ipv() == 6;
+    }
+    nc.stop_async();
+    async_stats st = nc.get_async_stats();
+    pub.records = st.sent;
+    pub.batches = st.batches;
+    CHECK(st.sent == n && st.dropped == 0);
+    return pub;
+}
+
+static published publish_flows(const char *subject, uint64_t n)
+{
+    nats_client nc;
+    nc.nats_client_connect();
+    async_options opt;
+    opt.policy = async_options::FULL_BLOCK;
+    opt.batch_bytes = 2048;
+    opt.batch_ms = 1;
+    nc.start_async(subject, opt);
+
+    published pub;
+    flow_v2 f;
+    string out;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        f.Clear();
+        f.set_first(1700000000000000 + i);
+        f.set_last(1700000000000000 + 2 * i);
+        f.set_packets(1 + i % 100);
+        f.set_bytes(100 * f.packets());
+        f.set_ipv(4);
+        f.set_s_ip4(0x0a000000 + i);
+        f.set_t_proto(TR_UDP);
+        f.set_end_reason(i % 5);
+        f.SerializeToString(&out);
+        CHECK(nc.publish_async(out.data(), out.size()));
+
+        pub.col0 += f.first();
+        pub.col2 += f.packets();
+    }
+    nc.stop_async();
+    async_stats st = nc.get_async_stats();
+    pub.records = st.sent;
+    pub.batches = st.batches;
+    CHECK(st.sent == n && st.dropped == 0);
+    return pub;
+}
+
+static ingest_options options(ingest_options::kind_t kind, const string &subject, const string &queue, const string &table, uint32_t workers)
+{
+    ingest_options opt;
+    opt.kind = kind;
+    opt.subject = subject;
+    opt.queue = queue;
+    opt.table = table;
+    opt.workers = workers;
+    opt.writer.max_rows = 1000;
+    return opt;
+}
+
+// a, b : one queue group ("sniff.ingest") of two processes, c : another group ("audit")
+static void queue_groups()
+{
+    database db("default", "", "localhost", 9000, "default");
+    nats_client na, nb, nc;
+    na.nats_client_connect();
+    nb.nats_client_connect();
+    nc.nats_client_connect();
+    ingest_server a(db, na, options(ingest_options::PACKS, "sniff.base", "sniff.ingest", "packs", 3));
+    ingest_server b(db, nb, options(ingest_options::PACKS, "sniff.base", "sniff.ingest", "packs", 2));
+    ingest_server c(db, nc, options(ingest_options::PACKS, "sniff.base", "audit", "packs_audit", 1));
+
+    vector<natsSubscription *> group;
+    {
+        lock_guard<mutex> lock(srv_m);
+        for (natsSubscription *s : srv_subs)
+        {
+            if (s->queue == "sniff.ingest")
+                group.push_back(s);
+        }
+    }
+    CHECK(group.size() == 5);
+
+    published pub = publish_packs("sniff.base", 20000);
+    // delivered counters are read before drain destroys the subscriptions
+    while (a.stats().messages + b.stats().messages < pub.batches || c.stats().messages < pub.batches)
+        this_thread::sleep_for(chrono::milliseconds(1));
+    uint64_t group_delivered = 0;
+    for (natsSubscription *s : group)
+    {
+        CHECK(s->delivered > 0);
+        group_delivered += s->delivered;
+    }
+
+    a.drain();
+    b.drain();
+    c.drain();
+    ingest_stats sa = a.stats(), sb = b.stats(), sc = c.stats();
+    cout << "queue groups : " << pub.batches << " batches, group members " << sa.messages << " + " << sb.messages
+         << ", other group " << sc.messages << endl;
+
+    // one copy per group
+    CHECK(group_delivered == pub.batches);
+    CHECK(sa.messages + sb.messages == pub.batches && sa.messages > 0 && sb.messages > 0);
+    CHECK(sc.messages == pub.batches);
+    CHECK(sa.bad + sb.bad + sc.bad == 0 && sa.insert_errors + sb.insert_errors + sc.insert_errors == 0);
+
+    // every record is a row, with its values
+    table_rows packs = rows_of("packs"), audit = rows_of("packs_audit");
+    CHECK(sa.records + sb.records == pub.records && sc.records == pub.records);
+    CHECK(sa.writer.rows + sb.writer.rows == pub.records && sc.writer.rows == pub.records);
+    CHECK(packs.rows == pub.records && audit.rows == pub.records);
+    CHECK(packs.col0 == pub.col0 && audit.col0 == pub.col0);
+    CHECK(packs.col2 == pub.col2 && packs.ipv6 == pub.ipv6);
+}
+
+static void flows_drained()
+{
+    database db("default", "", "localhost", 9000, "default");
+    nats_client sub;
+    sub.nats_client_connect();
+    ingest_server s(db, sub, options(ingest_options::FLOWS, "sniff.flows", "sniff.ingest", "flows", 4));
+
+    published pub = publish_flows("sniff.flows", 10000);
+    // drain right away : the messages still queued in the subscriptions are handled first
+    s.drain();
+    ingest_stats st = s.stats();
+    table_rows flows = rows_of("flows");
+    CHECK(st.messages == pub.batches);
+    CHECK(st.records == pub.records && st.writer.rows == pub.records);
+    CHECK(flows.rows == pub.records && flows.col0 == pub.col0 && flows.col2 == pub.col2);
+    CHECK(live_subscriptions() == 0);
+}
+
+// drain times out : the subscriptions are closed by drain, before ~ingest_server frees the workers
+static void drain_timeout()
+{
+    database db("default", "", "localhost", 9000, "default");
+    nats_client sub;
+    sub.nats_client_connect();
+    int freed = writers_freed, early = freed_while_delivering;
+    {
+        ingest_server s(db, sub, options(ingest_options::PACKS, "sniff.base", "sniff.ingest", "packs_timeout", 3));
+        publish_packs("sniff.base", 2000);
+
+        drain_stuck = true;
+        bool thrown = false;
+        try
+        {
+            s.drain(50);
+        }
+        catch (const runtime_error &)
+        {
+            thrown = true;
+        }
+        drain_stuck = false;
+        CHECK(thrown);
+        CHECK(live_subscriptions() == 0);
+
+        // nothing reaches the workers any more
+        uint64_t messages = s.stats().messages;
+        publish_packs("sniff.base", 1000);
+        CHECK(s.stats().messages == messages);
+    }
+    CHECK(writers_freed - freed == 3);
+    CHECK(freed_while_delivering == early);
+}
+
+// the third subscribe fails : the two subscriptions made are closed before the constructor frees the workers
+static void subscribe_error()
+{
+    database db("default", "", "localhost", 9000, "default");
+    nats_client sub;
+    sub.nats_client_connect();
+    int freed = writers_freed, early = freed_while_delivering;
+
+    subscribe_calls = 0;
+    fail_subscribe_at = 3;
+    bool thrown = false;
+    try
+    {
+        ingest_server s(db, sub, options(ingest_options::PACKS, "sniff.base", "sniff.ingest", "packs_error", 4));
+    }
+    catch (const runtime_error &)
+    {
+        thrown = true;
+    }
+    fail_subscribe_at = 0;
+    CHECK(thrown);
+    CHECK(writers_freed - freed == 4);
+    CHECK(freed_while_delivering == early);
+    CHECK(live_subscriptions() == 0);
+}
+
+int main()
+{
+    queue_groups();
+    flows_drained();
+    drain_timeout();
+    subscribe_error();
+
+    return check_result();
+}
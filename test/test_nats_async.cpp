@@ -0,0 +1,190 @@
+/*
+    nats_client async publishing with the publish path stubbed (stub/nats.h, no nats-server) :
+    for every full-queue policy, with producers still running while stop_async is called,
+    every record given to publish_async is either sent or dropped :
+    queued == accepted, queued + rejected == sent + dropped, sent == records found in the batches
+    and FULL_SAMPLE does not drop while the queue stays below 3/4
+*/
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+#include "../external/nats-client/nc.h"
+#include "check.h"
+
+using namespace std;
+
+// ---- stubbed nats.c
+
+static atomic<uint64_t> published{0}, bad_batches{0}, publish_calls{0};
+static atomic<int> fail_every{0};        // every n-th publish fails, 0 -> never
+static atomic<int> publish_delay_us{0}; // slow consumer -> the queue fills up
+
+// counts the records of a batch : (field 1, bytes)* then field 2, fixed64
+natsStatus natsConnection_Publish(natsConnection *, const char *, const void *data, int len)
+{
+    uint64_t call = ++publish_calls;
+    if (publish_delay_us > 0)
+        this_thread::sleep_for(chrono::microseconds(publish_delay_us));
+
+    const auto *p = static_cast<const unsigned char *>(data), *end = p + len;
+    uint64_t records = 0;
+    while (p < end && *p == ((1 << 3) | 2))
+    {
+        p++;
+        uint64_t l = 0;
+        int shift = 0;
+        while (p < end && (*p & 0x80))
+        {
+            l |= static_cast<uint64_t>(*p++ & 0x7f) << shift;
+            shift += 7;
+        }
+        if (p == end)
+            break;
+        l |= static_cast<uint64_t>(*p++) << shift;
+        p += l;
+        records++;
+    }
+    if (p + 9 != end || *p != ((2 << 3) | 1))
+        bad_batches++;
+
+    if (fail_every > 0 && call % fail_every == 0)
+        return NATS_ERR;
+    published += records;
+    return NATS_OK;
+}
+
+natsStatus natsConnection_ConnectTo(natsConnection **, const char *) { return NATS_ERR; }
+natsStatus natsConnection_FlushTimeout(natsConnection *, int64_t) { return NATS_OK; }
+natsStatus natsConnection_Subscribe(natsSubscription **, natsConnection *, const char *, natsMsgHandler, void *) { return NATS_ERR; }
+natsStatus natsConnection_QueueSubscribe(natsSubscription **, natsConnection *, const char *, const char *, natsMsgHandler, void *) { return NATS_ERR; }
+void natsConnection_Close(natsConnection *) {}
+void natsConnection_Destroy(natsConnection *) {}
+natsStatus natsSubscription_Drain(natsSubscription *) { return NATS_OK; }
+natsStatus natsSubscription_WaitForDrainCompletion(natsSubscription *, int64_t) { return NATS_OK; }
+natsStatus natsSubscription_GetDropped(natsSubscription *, int64_t *msgs)
+{
+    *msgs = 0;
+    return NATS_OK;
+}
+natsStatus natsSubscription_SetOnCompleteCB(natsSubscription *, natsOnCompleteCB, void *) { return NATS_OK; }
+natsStatus natsSubscription_Unsubscribe(natsSubscription *) { return NATS_OK; }
+void natsSubscription_Destroy(natsSubscription *) {}
+const char *natsMsg_GetData(const natsMsg *) { return nullptr; }
+int natsMsg_GetDataLength(const natsMsg *) { return 0; }
+void natsMsg_Destroy(natsMsg *) {}
+const char *natsStatus_GetText(natsStatus) { return "stub"; }
+
+// ---- tests
+
+static const char *policy_name(async_options::full_policy p)
+{
+    return p == async_options::FULL_DROP ? "FULL_DROP" : p == async_options::FULL_BLOCK ? "FULL_BLOCK" : "FULL_SAMPLE";
+}
+
+// producers publish until told to stop, stop_async is called while they still run
+static void stop_while_publishing(async_options::full_policy policy, int fail)
+{
+    published = 0;
+    bad_batches = 0;
+    publish_calls = 0;
+    fail_every = fail;
+    publish_delay_us = 20;
+
+    async_options opt;
+    opt.queue_size = 256;
+    opt.max_record = 64;
+    opt.batch_bytes = 4096;
+    opt.batch_ms = 1;
+    opt.policy = policy;
+    opt.sample_rate = 4;
+
+    nats_client nc;
+    nc.start_async("test", opt);
+
+    const int n_producers = 4;
+    atomic<bool> stop{false};
+    atomic<uint64_t> accepted{0}, rejected{0};
+    vector<thread> producers;
+    for (int t = 0; t < n_producers; t++)
+    {
+        producers.emplace_back([&, t]()
+                               {
+            char rec[80];
+            std::memset(rec, t, sizeof(rec));
+            for (uint64_t i = 0; !stop; i++)
+            {
+                size_t len = 1 + i % sizeof(rec); // some are above max_record
+                if (nc.publish_async(rec, len))
+                    accepted++;
+                else
+                    rejected++;
+            } });
+    }
+
+    this_thread::sleep_for(chrono::milliseconds(100));
+    nc.stop_async();
+    stop = true;
+    for (thread &th : producers)
+        th.join();
+
+    async_stats st = nc.get_async_stats();
+    cout << policy_name(policy) << (fail ? " with publish errors" : "") << " : queued " << st.queued << " sent " << st.sent
+         << " dropped " << st.dropped << " batches " << st.batches << " errors " << st.publish_errors << endl;
+
+    CHECK(st.queued == accepted);
+    CHECK(st.queued + rejected == st.sent + st.dropped);
+    CHECK(st.sent == published);
+    CHECK(st.queued > 0 && st.sent > 0);
+    CHECK(bad_batches == 0);
+    CHECK(fail == 0 || st.publish_errors > 0);
+}
+
+// a producer slower than the sender : the queue never reaches 3/4, nothing is sampled away
+static void sample_below_threshold()
+{
+    published = 0;
+    fail_every = 0;
+    publish_delay_us = 0;
+
+    async_options opt;
+    opt.queue_size = 1024;
+    opt.max_record = 64;
+    opt.batch_bytes = 4096;
+    opt.batch_ms = 1;
+    opt.policy = async_options::FULL_SAMPLE;
+    opt.sample_rate = 1000;
+
+    nats_client nc;
+    nc.start_async("test", opt);
+
+    char rec[32] = {};
+    for (int i = 0; i < 50; i++)
+    {
+        for (int j = 0; j < 64; j++)
+            CHECK(nc.publish_async(rec, sizeof(rec)));
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    nc.stop_async();
+
+    async_stats st = nc.get_async_stats();
+    CHECK(st.dropped == 0);
+    CHECK(st.sent == 50 * 64);
+    CHECK(published == 50 * 64);
+}
+
+int main()
+{
+    for (auto policy : {async_options::FULL_DROP, async_options::FULL_BLOCK, async_options::FULL_SAMPLE})
+    {
+        stop_while_publishing(policy, 0);
+        stop_while_publishing(policy, 7);
+    }
+    sample_below_threshold();
+
+    return check_result();
+}
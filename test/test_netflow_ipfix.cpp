@@ -0,0 +1,150 @@
+/*
+    netflow_v9_v10::decoder on IPFIX messages :
+    variable-length fields (1 byte length and 255 + 2 byte length), enterprise fields,
+    the message length (shorter than the header -> rejected, shorter than the datagram -> the rest is ignored)
+    and version values that only match 9 / 10 in their low byte
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include "../external/netflow_parser/netflow.hpp"
+#include "check.h"
+#include "netflow_export.h"
+
+using namespace std;
+using namespace netflow_v9_v10;
+
+static const auto exporter = template_key::from_ipv4(0x0a000001);
+static auto ignore_sets = [](const template_key &, const record_batch &) {};
+
+// decode error message, empty if decode did not throw
+static string decode_error(const vector<u_char> &packet, size_t length)
+{
+    decoder d;
+    record_batch batch;
+    try
+    {
+        d.decode(exporter, packet.data(), length, batch, ignore_sets);
+    }
+    catch (const runtime_error &e)
+    {
+        return e.what();
+    }
+    return "";
+}
+
+static void variable_length_and_enterprise()
+{
+    // src addr, interfaceName (variable), enterprise 9 / type 100, dst port
+    const vector<export_field> fields = {{8, 4}, {82, VARLEN}, {100, 4, 9}, {11, 2}};
+
+    export_packet_builder p(10);
+    p.tmpl(400, fields);
+
+    vector<u_char> short_name = {'e', 't', 'h', '0'}, long_name(300);
+    for (size_t i = 0; i < long_name.size(); i++)
+        long_name[i] = 'a' + i % 26;
+
+    size_t s = p.open_set(400);
+    p.be(0xc0a80001, 4);
+    p.varlen(short_name);
+    p.be(0x11223344, 4);
+    p.be(53, 2);
+    p.be(0xc0a80002, 4);
+    p.varlen(long_name);
+    p.be(0x55667788, 4);
+    p.be(443, 2);
+    p.be(0xc0a80003, 4);
+    p.varlen({});
+    p.be(7, 4);
+    p.be(80, 2);
+    p.close_set(s, false);
+
+    decoder d;
+    record_batch batch;
+    vector<vector<u_char>> names;
+    vector<uint64_t> addrs, ent, ports;
+    size_t field_count = 0;
+    int ent_col = -1, iana_100 = 0;
+    auto sink = [&](const template_key &key, const record_batch &b)
+    {
+        CHECK(key.version == 10 && key.id == 400);
+        field_count = b.tmpl->fields.size();
+        ent_col = b.tmpl->find(100, 9);
+        iana_100 = b.tmpl->find(100);
+        for (size_t r = 0; r < b.rows; r++)
+        {
+            addrs.push_back(b.u64(0, r));
+            auto [v, n] = b.raw(1, r);
+            names.emplace_back(v, v + n);
+            ent.push_back(b.u64(2, r));
+            ports.push_back(b.u64(3, r));
+        }
+    };
+
+    CHECK(d.decode(exporter, p.b.data(), p.b.size(), batch, sink) == 3);
+    CHECK(field_count == 4);
+    CHECK(ent_col == 2);
+    CHECK(iana_100 == -1);
+    CHECK((addrs == vector<uint64_t>{0xc0a80001, 0xc0a80002, 0xc0a80003}));
+    CHECK(names.size() == 3 && names[0] == short_name && names[1] == long_name && names[2].empty());
+    CHECK((ent == vector<uint64_t>{0x11223344, 0x55667788, 7}));
+    CHECK((ports == vector<uint64_t>{53, 443, 80}));
+
+    // a long form length running past the set is an error, not a read past the buffer
+    export_packet_builder bad(10);
+    bad.tmpl(400, fields);
+    s = bad.open_set(400);
+    bad.be(1, 4);
+    bad.u8(255);
+    bad.u16(1000);
+    bad.be(0, 8);
+    bad.close_set(s, false);
+    CHECK(!decode_error(bad.b, bad.b.size()).empty());
+}
+
+static void message_length()
+{
+    const vector<export_field> fields = {{8, 4}, {2, 4}};
+    export_packet_builder p(10);
+    p.tmpl(256, fields).data(256, fields, {{1, 10}, {2, 20}});
+
+    // below the 16 byte header
+    vector<u_char> short_len = p.b;
+    short_len[2] = 0;
+    short_len[3] = 10;
+    CHECK(decode_error(short_len, short_len.size()) == "netflow: IPFIX message length shorter than header");
+
+    // the datagram is longer than the message : the trailing bytes are not read as sets
+    vector<u_char> trailing = p.b;
+    trailing.insert(trailing.end(), {0x01, 0x00, 0x00, 0x08, 0xff, 0xff, 0xff, 0xff});
+    decoder d;
+    record_batch batch;
+    size_t rows = 0;
+    auto sink = [&rows](const template_key &, const record_batch &b)
+    { rows += b.rows; };
+    CHECK(d.decode(exporter, trailing.data(), trailing.size(), batch, sink) == 2);
+    CHECK(rows == 2);
+}
+
+static void version_high_byte()
+{
+    for (int version : {9, 10})
+    {
+        export_packet_builder p(version);
+        p.b[0] = 0x01; // 0x0109 / 0x010a
+        CHECK(decode_error(p.b, p.b.size()) == "Unexpected netflow version");
+    }
+}
+
+int main()
+{
+    variable_length_and_enterprise();
+    message_length();
+    version_high_byte();
+
+    return check_result();
+}
@@ -0,0 +1,216 @@
+/*
+    netflow_v9_v10 template_store / decoder :
+    two exporters with the same template id, data sets waiting for their template and replayed,
+    template and pending set expiry, and decoders on several threads sharing one store
+    (a data set that misses the template in the snapshot of its decoder while another decoder
+    publishes it is decoded, not left in the pending queue)
+*/
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include "../external/netflow_parser/netflow.hpp"
+#include "check.h"
+#include "netflow_export.h"
+
+using namespace std;
+using namespace netflow_v9_v10;
+
+// v9 packets of one source id
+struct v9_packet : export_packet_builder
+{
+    explicit v9_packet(uint32_t source_id = 1) : export_packet_builder(9, source_id) {}
+};
+
+static const vector<export_field> fields_a = {{8, 4}, {2, 4}};         // src addr, packets
+static const vector<export_field> fields_b = {{7, 2}, {11, 2}, {4, 1}}; // ports, protocol
+
+struct collected
+{
+    size_t rows = 0, sets = 0;
+    vector<uint64_t> first_col;
+    size_t field_count = 0;
+};
+
+static void same_id_two_exporters()
+{
+    auto store = make_shared<template_store>();
+    decoder d(store);
+    record_batch batch;
+    auto ea = template_key::from_ipv4(0x0a000001), eb = template_key::from_ipv4(0x0a000002);
+
+    collected a, b;
+    auto sink_to = [](collected &c)
+    {
+        return [&c](const template_key &, const record_batch &bt)
+        {
+            c.sets++;
+            c.rows += bt.rows;
+            c.field_count = bt.tmpl->fields.size();
+            for (size_t r = 0; r < bt.rows; r++)
+                c.first_col.push_back(bt.u64(0, r));
+        };
+    };
+
+    v9_packet pa, pb;
+    pa.tmpl(256, fields_a).data(256, fields_a, {{0xc0a80001, 10}, {0xc0a80002, 20}});
+    pb.tmpl(256, fields_b).data(256, fields_b, {{443, 51000, 6}});
+    CHECK(d.decode(ea, pa.b.data(), pa.b.size(), batch, sink_to(a)) == 2);
+    CHECK(d.decode(eb, pb.b.data(), pb.b.size(), batch, sink_to(b)) == 1);
+
+    // data only : each exporter keeps its own template 256
+    v9_packet qa, qb;
+    qa.data(256, fields_a, {{0xc0a80003, 30}});
+    qb.data(256, fields_b, {{53, 40000, 17}, {80, 40001, 6}});
+    CHECK(d.decode(ea, qa.b.data(), qa.b.size(), batch, sink_to(a)) == 1);
+    CHECK(d.decode(eb, qb.b.data(), qb.b.size(), batch, sink_to(b)) == 2);
+
+    CHECK(a.field_count == 2 && b.field_count == 3);
+    CHECK((a.first_col == vector<uint64_t>{0xc0a80001, 0xc0a80002, 0xc0a80003}));
+    CHECK((b.first_col == vector<uint64_t>{443, 53, 80}));
+    CHECK(store->stats().templates == 2);
+
+    // another observation domain of the same exporter does not see them
+    v9_packet other(2);
+    other.data(256, fields_a, {{1, 1}});
+    CHECK(d.decode(ea, other.b.data(), other.b.size(), batch, sink_to(a)) == 0);
+    CHECK(d.stats().no_template == 1);
+}
+
+static void defer_and_replay()
+{
+    auto store = make_shared<template_store>();
+    decoder d(store);
+    record_batch batch;
+    auto e = template_key::from_ipv4(0x0a000001);
+
+    collected c;
+    auto sink = [&c](const template_key &, const record_batch &bt)
+    {
+        c.rows += bt.rows;
+        for (size_t r = 0; r < bt.rows; r++)
+            c.first_col.push_back(bt.u64(0, r));
+    };
+
+    v9_packet d1, d2;
+    d1.data(300, fields_a, {{1, 0}, {2, 0}});
+    d2.data(300, fields_a, {{3, 0}});
+    CHECK(d.decode(e, d1.b.data(), d1.b.size(), batch, sink) == 0);
+    CHECK(d.decode(e, d2.b.data(), d2.b.size(), batch, sink) == 0);
+    CHECK(d.stats().no_template == 2);
+    CHECK(store->stats().pending == 2);
+
+    // the template replays both sets in arrival order, then the data set of the same packet
+    v9_packet t;
+    t.tmpl(300, fields_a).data(300, fields_a, {{4, 0}});
+    CHECK(d.decode(e, t.b.data(), t.b.size(), batch, sink) == 4);
+    CHECK((c.first_col == vector<uint64_t>{1, 2, 3, 4}));
+    CHECK(d.stats().replayed == 3);
+    CHECK(store->stats().replayed == 2);
+
+    // nothing is left to replay
+    CHECK(store->take_pending(template_key{e, 1, 300, 9}).empty());
+}
+
+static void expiry()
+{
+    store_options opt;
+    opt.template_timeout = chrono::seconds(10);
+    opt.pending_timeout = chrono::seconds(5);
+    auto store = make_shared<template_store>(opt);
+    decoder d(store);
+    record_batch batch;
+    auto e = template_key::from_ipv4(0x0a000001);
+    auto sink = [](const template_key &, const record_batch &) {};
+
+    v9_packet t, waiting;
+    t.tmpl(256, fields_a);
+    waiting.data(257, fields_a, {{1, 1}});
+    d.decode(e, t.b.data(), t.b.size(), batch, sink);
+    d.decode(e, waiting.b.data(), waiting.b.size(), batch, sink);
+    CHECK(store->stats().templates == 1);
+    CHECK(store->stats().pending == 1);
+
+    int64_t now = template_store::now_ms();
+    template_key k{e, 1, 256, 9};
+    CHECK(store->find(store->get(), k, now + 9000) != nullptr);
+    CHECK(store->find(store->get(), k, now + 11000) == nullptr);
+
+    // pending set older than pending_timeout, template still valid
+    store->expire(now + 6000);
+    CHECK(store->stats().pending_dropped == 1);
+    CHECK(store->stats().templates == 1);
+    CHECK(store->take_pending(template_key{e, 1, 257, 9}).empty());
+
+    store->expire(now + 11000);
+    CHECK(store->stats().templates == 0);
+    CHECK(store->stats().expired == 1);
+}
+
+/*
+    per key : one thread sends a packet of many data sets, another one the template, at the same time
+    every set is decoded exactly once (directly or replayed), nothing stays pending
+*/
+static void concurrent_decoders()
+{
+    const int keys = 2000, sets = 32;
+    auto store = make_shared<template_store>();
+
+    vector<v9_packet> templates, datas;
+    for (int k = 0; k < keys; k++)
+    {
+        templates.emplace_back(k + 1).tmpl(256, fields_a);
+        datas.emplace_back(k + 1);
+        for (int s = 0; s < sets; s++)
+            datas.back().data(256, fields_a, {{uint64_t(k), uint64_t(s)}});
+    }
+    auto e = template_key::from_ipv4(0x0a000001);
+
+    atomic<uint64_t> rows{0};
+    atomic<int> ready{0};
+    auto sink = [&rows](const template_key &, const record_batch &bt)
+    { rows += bt.rows; };
+
+    auto run = [&](vector<v9_packet> &packets, int me)
+    {
+        decoder d(store);
+        record_batch batch;
+        for (int k = 0; k < keys; k++)
+        {
+            // both threads start the same key together
+            ready++;
+            while (ready < 2 * (k + 1))
+                this_thread::yield();
+            if (me == 1)
+                this_thread::yield();
+            d.decode(e, packets[k].b.data(), packets[k].b.size(), batch, sink);
+        }
+    };
+
+    thread td([&]()
+              { run(datas, 0); });
+    thread tt([&]()
+              { run(templates, 1); });
+    td.join();
+    tt.join();
+
+    store_stats st = store->stats();
+    cout << "concurrent : " << rows << " of " << keys * sets << " records, " << st.pending << " deferred, "
+         << st.replayed << " replayed, " << st.pending_dropped << " dropped" << endl;
+    CHECK(rows == uint64_t(keys) * sets);
+    CHECK(st.pending == st.replayed);
+    CHECK(st.pending_dropped == 0);
+}
+
+int main()
+{
+    same_id_two_exporters();
+    defer_and_replay();
+    expiry();
+    concurrent_decoders();
+
+    return check_result();
+}
@@ -0,0 +1,254 @@
+/*
+    table_writer against stub/clickhouse (Client::Insert defined here, no server) :
+    appends go to the second buffer while the first one is inserted, blocks keep the append order,
+    a buffer older than max_age is inserted without flush, an Append that throws leaves no partial row,
+    and a failed insert is rethrown once from the next append / flush
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <functional>
+#include <algorithm>
+#include <array>
+
+#include "../external/database/db.h"
+#include "check.h"
+
+using namespace std;
+using namespace clickhouse;
+
+// ---- stubbed clickhouse Client
+
+struct inserted_block
+{
+    size_t rows;
+    vector<uint64_t> first; // values of column 0
+    vector<in_addr_t> ip;   // values of column 1 if it is IPv4
+};
+
+static mutex inserted_m;
+static vector<inserted_block> inserted;
+static atomic<int> insert_delay_ms{0};
+static atomic<bool> fail_insert{false};
+
+Client::Client(const ClientOptions &) {}
+Client::~Client() {}
+void Client::Execute(const string &) {}
+
+void Client::Insert(const string &, const Block &block)
+{
+    if (insert_delay_ms > 0)
+        this_thread::sleep_for(chrono::milliseconds(insert_delay_ms));
+    if (fail_insert)
+        throw runtime_error("insert failed");
+
+    // a row left in one column only (Append rollback) shows up as columns of different sizes
+    inserted_block b{block.GetRowCount(), {}, {}};
+    bool same_size = true;
+    for (size_t c = 0; c < block.GetColumnCount(); c++)
+        same_size = same_size && block[c]->Size() == b.rows;
+    CHECK(same_size);
+    for (size_t i = 0; same_size && i < b.rows; i++)
+    {
+        if (auto c = block[0]->As<ColumnUInt32>())
+            b.first.push_back(c->At(i));
+        else if (auto c = block[0]->As<ColumnUInt64>())
+            b.first.push_back(c->At(i));
+        if (auto c = block.GetColumnCount() > 1 ? block[1]->As<ColumnIPv4>() : nullptr)
+            b.ip.push_back(c->At(i));
+    }
+    lock_guard<mutex> lock(inserted_m);
+    inserted.push_back(std::move(b));
+}
+
+static void reset()
+{
+    lock_guard<mutex> lock(inserted_m);
+    inserted.clear();
+    insert_delay_ms = 0;
+    fail_insert = false;
+}
+
+static vector<uint64_t> inserted_values()
+{
+    lock_guard<mutex> lock(inserted_m);
+    vector<uint64_t> v;
+    for (const inserted_block &b : inserted)
+        v.insert(v.end(), b.first.begin(), b.first.end());
+    return v;
+}
+
+// ---- tests
+
+using u64_writer = table_writer<ColumnUInt64, ColumnUInt32>;
+using ip_writer = table_writer<ColumnUInt32, ColumnIPv4>;
+
+static const array<string, 2> names = {"a", "b"};
+
+// max_rows swaps the buffers, the caller keeps appending while the other buffer is inserted
+static void buffer_swap()
+{
+    reset();
+    insert_delay_ms = 200;
+    writer_options opt;
+    opt.max_rows = 100;
+    opt.max_age = chrono::seconds(60);
+    u64_writer w(ClientOptions(), "t", names, opt);
+
+    for (uint64_t i = 0; i < 100; i++)
+        w.append(i, uint32_t(i));
+    // the first buffer is being inserted : these rows only fill the second one
+    auto start = chrono::steady_clock::now();
+    for (uint64_t i = 100; i < 199; i++)
+        w.append(i, uint32_t(i));
+    CHECK(chrono::steady_clock::now() - start < chrono::milliseconds(100));
+
+    insert_delay_ms = 0;
+    for (uint64_t i = 199; i < 1050; i++)
+        w.append(i, uint32_t(i));
+    w.flush();
+
+    vector<uint64_t> v = inserted_values();
+    bool in_order = v.size() == 1050;
+    for (size_t i = 0; in_order && i < v.size(); i++)
+        in_order = v[i] == i;
+    CHECK(in_order);
+    {
+        lock_guard<mutex> lock(inserted_m);
+        CHECK(inserted.size() == 11);
+        for (size_t i = 0; i < inserted.size(); i++)
+            CHECK(inserted[i].rows == (i < 10 ? 100 : 50));
+    }
+    writer_stats st = w.stats();
+    CHECK(st.inserts == 11 && st.rows == 1050 && st.errors == 0);
+}
+
+// rows below max_rows are inserted max_age after the first one, without flush
+static void age_flush()
+{
+    reset();
+    writer_options opt;
+    opt.max_age = chrono::milliseconds(50);
+    u64_writer w(ClientOptions(), "t", names, opt);
+
+    auto start = chrono::steady_clock::now();
+    for (uint64_t i = 0; i < 5; i++)
+        w.append(i, uint32_t(i));
+    while (w.stats().inserts == 0 && chrono::steady_clock::now() - start < chrono::seconds(5))
+        this_thread::sleep_for(chrono::milliseconds(1));
+
+    CHECK(w.stats().inserts == 1);
+    CHECK(chrono::steady_clock::now() - start >= chrono::milliseconds(50));
+    CHECK((inserted_values() == vector<uint64_t>{0, 1, 2, 3, 4}));
+
+    // the timer starts again with the next first row
+    w.append(uint64_t(5), uint32_t(5));
+    start = chrono::steady_clock::now();
+    while (w.stats().inserts == 1 && chrono::steady_clock::now() - start < chrono::seconds(5))
+        this_thread::sleep_for(chrono::milliseconds(1));
+    CHECK(w.stats().inserts == 2 && w.stats().rows == 6);
+}
+
+// ColumnIPv4::Append(string) throws on a bad address : the value already in column 0 is removed
+static void append_rollback()
+{
+    reset();
+    ip_writer w(ClientOptions(), "t", names);
+
+    w.append(1u, string("10.0.0.1"));
+    bool thrown = false;
+    try
+    {
+        w.append(2u, string("not an address"));
+    }
+    catch (const ValidationError &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    w.append(3u, string("10.0.0.3"));
+
+    // bulk : the rows appended to column 0 before column 1 throws are removed too
+    const uint32_t a[3] = {4, 5, 6};
+    const string b[3] = {"10.0.0.4", "bad", "10.0.0.6"};
+    thrown = false;
+    try
+    {
+        w.append_columns(3, a, b);
+    }
+    catch (const ValidationError &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    w.flush();
+
+    lock_guard<mutex> lock(inserted_m);
+    CHECK(inserted.size() == 1);
+    CHECK(!inserted.empty() && inserted[0].rows == 2);
+    CHECK(!inserted.empty() && (inserted[0].first == vector<uint64_t>{1, 3}));
+    CHECK(!inserted.empty() && (inserted[0].ip == vector<in_addr_t>{inet_addr("10.0.0.1"), inet_addr("10.0.0.3")}));
+}
+
+static bool throws(const function<void()> &f)
+{
+    try
+    {
+        f();
+    }
+    catch (const runtime_error &e)
+    {
+        return string(e.what()) == "insert failed";
+    }
+    return false;
+}
+
+// the background insert error is rethrown once, by flush or by the next append
+static void insert_error()
+{
+    reset();
+    writer_options opt;
+    opt.max_rows = 1;
+    u64_writer w(ClientOptions(), "t", names, opt);
+
+    // flush waits for the insert and rethrows its error
+    fail_insert = true;
+    CHECK(throws([&]()
+                 { w.append(uint64_t(1), 1u); w.flush(); }));
+    fail_insert = false;
+    CHECK(!throws([&]()
+                  { w.append(uint64_t(2), 2u); w.flush(); }));
+
+    // max_rows = 1 : every append hands its row to the inserter, the failure comes back from an append
+    fail_insert = true;
+    w.append(uint64_t(3), 3u);
+    while (w.stats().errors < 2)
+        this_thread::sleep_for(chrono::milliseconds(1));
+    fail_insert = false;
+    CHECK(throws([&]()
+                  { w.append(uint64_t(4), 4u); }));
+    CHECK(!throws([&]()
+                  { w.append(uint64_t(5), 5u); w.flush(); }));
+
+    writer_stats st = w.stats();
+    CHECK(st.errors == 2);
+    vector<uint64_t> v = inserted_values();
+    CHECK(!v.empty() && v.front() == 2 && v.back() == 5);
+    CHECK(find(v.begin(), v.end(), 1) == v.end() && find(v.begin(), v.end(), 3) == v.end());
+}
+
+int main()
+{
+    buffer_swap();
+    age_flush();
+    append_rollback();
+    insert_error();
+
+    return check_result();
+}